@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    BPM Key Batch Analyzer
+    Headless CLI that runs the plugin's detectors over whole libraries:
+    memory-mapped readers, worker-thread fan-out, JSON-lines output
+
+    Usage:
+      BPMKeyBatch [--threads N] <files or directories...>
+
+    One JSON object per analyzed file is written to stdout; errors go to
+    stderr so output can be piped straight into a tagging pipeline.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include <cstdio>
+
+#include "../../Source/BPMDetector.h"
+#include "../../Source/KeyDetector.h"
+#include "../../Source/Decimator.h"
+
+//==============================================================================
+// The BPM detector's streaming workspace covers 60 seconds; analyzing more
+// than that doesn't improve tag quality anyway, so longer files are clamped
+static constexpr double maxAnalysisSeconds = 60.0;
+
+static juce::CriticalSection outputLock;
+
+//==============================================================================
+static std::unique_ptr<juce::MemoryMappedAudioFormatReader> openMappedReader(
+    const juce::File& file)
+{
+    // Memory-mapped readers pull samples straight out of the page cache
+    // instead of decoding the whole file into a heap copy first
+    juce::WavAudioFormat wavFormat;
+    juce::AiffAudioFormat aiffFormat;
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader;
+
+    if (file.hasFileExtension("wav"))
+        reader.reset(wavFormat.createMemoryMappedReader(file));
+    else if (file.hasFileExtension("aif;aiff"))
+        reader.reset(aiffFormat.createMemoryMappedReader(file));
+
+    if (reader != nullptr && !reader->mapEntireFile())
+        reader = nullptr;
+
+    return reader;
+}
+
+static void printError(const juce::File& file, const char* message)
+{
+    const juce::ScopedLock sl(outputLock);
+    std::fprintf(stderr, "error file=\"%s\" message=\"%s\"\n",
+                 file.getFullPathName().toRawUTF8(), message);
+}
+
+//==============================================================================
+static void analyzeFile(const juce::File& file)
+{
+    auto reader = openMappedReader(file);
+
+    if (reader == nullptr)
+    {
+        printError(file, "unsupported format or mapping failed");
+        return;
+    }
+
+    double sampleRate = reader->sampleRate;
+    int numChannels = static_cast<int>(reader->numChannels);
+    auto totalSamples = reader->lengthInSamples;
+
+    if (sampleRate <= 0.0 || numChannels <= 0 || totalSamples <= 0)
+    {
+        printError(file, "empty or malformed audio");
+        return;
+    }
+
+    int numSamples = static_cast<int>(juce::jmin<juce::int64>(totalSamples,
+        static_cast<juce::int64>(sampleRate * maxAnalysisSeconds)));
+
+    // Read out of the mapping and mix to mono in one pass
+    juce::AudioBuffer<float> audio(numChannels, numSamples);
+
+    if (!reader->read(&audio, 0, numSamples, 0, true, numChannels > 1))
+    {
+        printError(file, "read failed");
+        return;
+    }
+
+    float* mono = audio.getWritePointer(0);
+
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::add(mono, audio.getReadPointer(channel), numSamples);
+
+    if (numChannels > 1)
+        juce::FloatVectorOperations::multiply(mono, 1.0f / static_cast<float>(numChannels),
+                                              numSamples);
+
+    // Same pipeline as the plugin: full-rate BPM, decimated key
+    auto analysisStart = juce::Time::getHighResolutionTicks();
+
+    BPMDetector bpmDetector;
+    bpmDetector.prepare(sampleRate);
+    float bpm = bpmDetector.detectBPM(mono, numSamples);
+    float bpmConfidence = bpmDetector.getConfidence();
+
+    Decimator decimator;
+    decimator.prepare(sampleRate);
+    std::vector<float> decimated(static_cast<size_t>(decimator.getMaxOutputSamples(numSamples)));
+    int numDecimated = decimator.process(mono, numSamples, decimated.data());
+
+    KeyDetector keyDetector;
+    keyDetector.prepare(decimator.getOutputSampleRate(),
+                        juce::jmin(maxAnalysisSeconds, numSamples / sampleRate));
+    auto [key, mode, keyConfidence] = keyDetector.detectKey(decimated.data(), numDecimated);
+
+    double analysisSeconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - analysisStart);
+
+    // One JSON object per file, matching the field names the Python stages
+    // export for batch runs
+    auto* result = new juce::DynamicObject();
+    result->setProperty("file", file.getFullPathName());
+    result->setProperty("bpm", bpm);
+    result->setProperty("bpm_confidence", bpmConfidence);
+    result->setProperty("key", key);
+    result->setProperty("mode", mode);
+    result->setProperty("key_string", key + " " + mode);
+    result->setProperty("key_confidence", keyConfidence);
+    result->setProperty("duration", static_cast<double>(totalSamples) / sampleRate);
+    result->setProperty("analysis_time", analysisSeconds);
+
+    auto line = juce::JSON::toString(juce::var(result), true);
+
+    const juce::ScopedLock sl(outputLock);
+    std::printf("%s\n", line.toRawUTF8());
+    std::fflush(stdout);
+}
+
+//==============================================================================
+static void collectFiles(const juce::File& target, juce::Array<juce::File>& files)
+{
+    if (target.isDirectory())
+    {
+        for (const auto& entry : target.findChildFiles(
+                 juce::File::findFiles, true, "*.wav;*.aif;*.aiff"))
+            files.add(entry);
+    }
+    else if (target.existsAsFile())
+    {
+        files.add(target);
+    }
+}
+
+//==============================================================================
+int main (int argc, char** argv)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    int numThreads = juce::SystemStats::getNumCpus();
+    juce::Array<juce::File> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        juce::String arg(argv[i]);
+
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            numThreads = juce::jlimit(1, 64, juce::String(argv[++i]).getIntValue());
+            continue;
+        }
+
+        collectFiles(juce::File::getCurrentWorkingDirectory().getChildFile(arg), files);
+    }
+
+    if (files.isEmpty())
+    {
+        std::fprintf(stderr, "usage: BPMKeyBatch [--threads N] <files or directories...>\n");
+        return 1;
+    }
+
+    // Fan the library out across the pool; each job is self-contained so
+    // throughput scales with cores until the page cache becomes the limit
+    juce::ThreadPool pool(numThreads);
+
+    for (const auto& file : files)
+        pool.addJob([file] { analyzeFile(file); });
+
+    while (pool.getNumJobs() > 0)
+        juce::Thread::sleep(10);
+
+    return 0;
+}
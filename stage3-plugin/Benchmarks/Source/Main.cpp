@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    Detector Kernel Microbenchmarks
+    Headless timing harness for the analysis pipeline stages
+
+    Output is one "bench ..." line per measurement with stable key=value
+    fields so runs can be diffed across commits.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "../../Source/BPMDetector.h"
+#include "../../Source/KeyDetector.h"
+#include "../../Source/STFTEngine.h"
+#include "../../Source/Decimator.h"
+
+//==============================================================================
+// Synthetic test signals
+
+static std::vector<float> makeClickTrack(double sampleRate, double seconds, double bpm)
+{
+    std::vector<float> signal(static_cast<size_t>(sampleRate * seconds), 0.0f);
+
+    int samplesPerBeat = static_cast<int>(sampleRate * 60.0 / bpm);
+    int clickLength = static_cast<int>(sampleRate * 0.01); // 10 ms decaying click
+
+    for (size_t start = 0; start < signal.size(); start += static_cast<size_t>(samplesPerBeat))
+        for (int i = 0; i < clickLength && start + static_cast<size_t>(i) < signal.size(); ++i)
+            signal[start + static_cast<size_t>(i)] = 0.9f * (1.0f - i / static_cast<float>(clickLength));
+
+    return signal;
+}
+
+static std::vector<float> makeChordDrone(double sampleRate, double seconds)
+{
+    // A minor triad: A3, C4, E4
+    const double frequencies[] = { 220.0, 261.63, 329.63 };
+    std::vector<float> signal(static_cast<size_t>(sampleRate * seconds), 0.0f);
+
+    for (double freq : frequencies)
+    {
+        double phasePerSample = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        for (size_t i = 0; i < signal.size(); ++i)
+            signal[i] += 0.2f * static_cast<float>(std::sin(phasePerSample * static_cast<double>(i)));
+    }
+
+    return signal;
+}
+
+static std::vector<float> makeNoise(double sampleRate, double seconds)
+{
+    juce::Random random(42); // fixed seed for reproducible runs
+    std::vector<float> signal(static_cast<size_t>(sampleRate * seconds));
+
+    for (float& sample : signal)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+
+    return signal;
+}
+
+//==============================================================================
+// Timing
+
+static double bestSeconds(const std::function<void()>& work, int repeats = 5)
+{
+    double best = 1.0e30;
+
+    for (int i = 0; i < repeats; ++i)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        work();
+        double elapsed = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start);
+        best = juce::jmin(best, elapsed);
+    }
+
+    return best;
+}
+
+static void report(const char* stage, const char* signal, double sampleRate,
+                   double windowSeconds, int frames, double seconds)
+{
+    double nsPerFrame = frames > 0 ? seconds * 1.0e9 / frames : 0.0;
+
+    std::printf("bench stage=%s signal=%s sr=%d window_s=%g frames=%d ns_per_frame=%.0f total_ms=%.3f\n",
+                stage, signal, static_cast<int>(sampleRate), windowSeconds,
+                frames, nsPerFrame, seconds * 1.0e3);
+}
+
+//==============================================================================
+
+static void benchmarkConfiguration(double sampleRate, double windowSeconds)
+{
+    struct NamedSignal { const char* name; std::vector<float> samples; };
+
+    NamedSignal signals[] = {
+        { "clicks_120bpm", makeClickTrack(sampleRate, windowSeconds, 120.0) },
+        { "chord_a_minor", makeChordDrone(sampleRate, windowSeconds) },
+        { "noise",         makeNoise(sampleRate, windowSeconds) },
+    };
+
+    for (auto& signal : signals)
+    {
+        int numSamples = static_cast<int>(signal.samples.size());
+        const float* data = signal.samples.data();
+
+        // Shared STFT pass
+        {
+            STFTEngine engine;
+            engine.prepare(sampleRate, numSamples);
+            double seconds = bestSeconds([&] { engine.analyze(data, numSamples); });
+            report("stft_analyze", signal.name, sampleRate, windowSeconds,
+                   engine.getNumFrames(), seconds);
+        }
+
+        // Batch BPM detection, end to end
+        {
+            BPMDetector detector;
+            detector.prepare(sampleRate);
+            int frames = (numSamples - 2048) / 512;
+            double seconds = bestSeconds([&] { detector.detectBPM(data, numSamples); });
+            report("detect_bpm_batch", signal.name, sampleRate, windowSeconds, frames, seconds);
+        }
+
+        // Streaming onset envelope + incremental tempo estimate
+        {
+            BPMDetector detector;
+            detector.prepare(sampleRate);
+            int frames = (numSamples - 2048) / 512;
+            double seconds = bestSeconds([&]
+            {
+                detector.resetStream();
+                detector.pushAudio(data, numSamples);
+                detector.detectBPMIncremental();
+            });
+            report("detect_bpm_stream", signal.name, sampleRate, windowSeconds, frames, seconds);
+        }
+
+        // Decimation pre-stage
+        Decimator decimator;
+        decimator.prepare(sampleRate);
+        std::vector<float> decimated(static_cast<size_t>(decimator.getMaxOutputSamples(numSamples)));
+        int numDecimated = 0;
+        {
+            double seconds = bestSeconds([&]
+            {
+                numDecimated = decimator.process(data, numSamples, decimated.data());
+            });
+            report("decimate", signal.name, sampleRate, windowSeconds, numSamples / 512, seconds);
+        }
+
+        // Batch key detection on the decimated signal, end to end
+        {
+            KeyDetector detector;
+            detector.prepare(decimator.getOutputSampleRate(), windowSeconds);
+            int frames = juce::jmax(0, (numDecimated - 4096) / 512);
+            double seconds = bestSeconds([&] { detector.detectKey(decimated.data(), numDecimated); });
+            report("detect_key_batch", signal.name, sampleRate, windowSeconds, frames, seconds);
+        }
+
+        // Streaming chromagram + incremental key estimate
+        {
+            KeyDetector detector;
+            detector.prepare(decimator.getOutputSampleRate(), windowSeconds);
+            int frames = juce::jmax(0, (numDecimated - 4096) / 512);
+            double seconds = bestSeconds([&]
+            {
+                detector.resetStream();
+                detector.pushAudio(decimated.data(), numDecimated);
+                detector.detectKeyIncremental();
+            });
+            report("detect_key_stream", signal.name, sampleRate, windowSeconds, frames, seconds);
+        }
+    }
+}
+
+//==============================================================================
+int main (int, char**)
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    const double windowLengths[] = { 5.0, 10.0 };
+
+    for (double sampleRate : sampleRates)
+        for (double windowSeconds : windowLengths)
+            benchmarkConfiguration(sampleRate, windowSeconds);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    Shared Analysis Service Implementation
+
+  ==============================================================================
+*/
+
+#include "AnalysisService.h"
+
+AnalysisService::AnalysisService()
+    : Thread("BPM Key Analysis Scheduler"),
+      pool(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2))
+{
+    startThread();
+}
+
+AnalysisService::~AnalysisService()
+{
+    stopThread(2000);
+    pool.removeAllJobs(true, 4000);
+}
+
+void AnalysisService::registerClient(Client* client)
+{
+    const juce::ScopedLock sl(clientLock);
+
+    auto* state = new ClientState();
+    state->client = client;
+    clients.add(state);
+}
+
+void AnalysisService::unregisterClient(Client* client)
+{
+    std::unique_ptr<ClientState> removed;
+
+    {
+        const juce::ScopedLock sl(clientLock);
+
+        for (int i = clients.size(); --i >= 0;)
+            if (clients.getUnchecked(i)->client == client)
+                removed.reset(clients.removeAndReturn(i));
+    }
+
+    // The pool job only touches the state/client before clearing the flag,
+    // so once it drops we can safely let both go
+    if (removed != nullptr)
+        while (removed->jobPending.load())
+            juce::Thread::sleep(1);
+}
+
+void AnalysisService::run()
+{
+    while (!threadShouldExit())
+    {
+        scheduleDueClients(true);
+        scheduleDueClients(false);
+
+        wait(pollIntervalMs);
+    }
+}
+
+void AnalysisService::scheduleDueClients(bool urgentOnly)
+{
+    const juce::ScopedLock sl(clientLock);
+
+    for (auto* state : clients)
+    {
+        if (state->jobPending.load()
+         || state->client->isAnalysisJobUrgent() != urgentOnly
+         || !state->client->isAnalysisDue())
+            continue;
+
+        state->jobPending.store(true);
+
+        pool.addJob([state]
+        {
+            state->client->runAnalysisJob();
+            state->jobPending.store(false);
+        });
+    }
+}
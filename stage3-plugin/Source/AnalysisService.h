@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    Shared Analysis Service
+    One bounded pool of analysis threads for every plugin instance in the
+    process, instead of a worker thread per instance
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Process-wide analysis scheduler. Plugin instances register as clients;
+    a single scheduler thread polls them and submits due analysis passes to
+    one bounded thread pool, with at most one job in flight per client and
+    urgent clients (the focused editor) scheduled first. Shared between
+    instances via juce::SharedResourcePointer.
+*/
+class AnalysisService : private juce::Thread
+{
+public:
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        /** Asked on the scheduler thread whether this instance wants an
+            analysis pass right now. Must be cheap and non-blocking. */
+        virtual bool isAnalysisDue() = 0;
+
+        /** The actual analysis work, executed on the shared pool. */
+        virtual void runAnalysisJob() = 0;
+
+        /** Urgent clients are scheduled ahead of the rest. */
+        virtual bool isAnalysisJobUrgent() { return false; }
+    };
+
+    AnalysisService();
+    ~AnalysisService() override;
+
+    void registerClient(Client* client);
+
+    /** Removes the client, blocking until any in-flight job has finished. */
+    void unregisterClient(Client* client);
+
+private:
+    struct ClientState
+    {
+        Client* client = nullptr;
+        std::atomic<bool> jobPending { false }; // coalesces repeated requests
+    };
+
+    void run() override;
+    void scheduleDueClients(bool urgentOnly);
+
+    static constexpr int pollIntervalMs = 100;
+
+    juce::ThreadPool pool;
+    juce::CriticalSection clientLock;
+    juce::OwnedArray<ClientState> clients;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisService)
+};
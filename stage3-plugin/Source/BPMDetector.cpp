@@ -9,9 +9,22 @@
 
 #include "BPMDetector.h"
 
+#include <cstring>
+
 void BPMDetector::prepare(double sr)
 {
     sampleRate = sr;
+
+    // Flux band table - the frame and band buffers themselves are
+    // fixed-size members now
+    buildFluxBandTable(Pipeline::numBins, sampleRate / fftSize, fluxBandOfBin);
+
+    // Inputs longer than the reserve fall back to amortized growth
+    onsetEnvelope.reserve(static_cast<size_t>(sampleRate * maxWindowSeconds / hopSize));
+
+    // Streamed-envelope state
+    envelopeRing.assign(static_cast<size_t>(sampleRate * maxWindowSeconds / hopSize), 0.0f);
+    resetStream();
 }
 
 float BPMDetector::detectBPM(const float* audioData, int numSamples)
@@ -20,9 +33,178 @@ float BPMDetector::detectBPM(const float* audioData, int numSamples)
         return 0.0f;
 
     // Calculate onset strength envelope
-    std::vector<float> onsetStrength;
-    calculateOnsetStrength(audioData, numSamples, onsetStrength);
+    calculateOnsetStrength(audioData, numSamples, onsetEnvelope);
+
+    return finalizeBPM(onsetEnvelope);
+}
+
+void BPMDetector::pushAudio(const float* audioData, int numSamples)
+{
+    int pos = 0;
+
+    while (pos < numSamples)
+    {
+        int toCopy = juce::jmin(numSamples - pos, fftSize - streamFill);
+        juce::FloatVectorOperations::copy(streamBuffer.data() + streamFill,
+                                          audioData + pos, toCopy);
+        streamFill += toCopy;
+        pos += toCopy;
+
+        if (streamFill == fftSize)
+        {
+            // Append one flux value and slide the assembly buffer by a hop
+            envelopeRing[static_cast<size_t>(envelopeRingPos)] = computeFrameFlux(streamBuffer.data());
+            envelopeRingPos = (envelopeRingPos + 1) % static_cast<int>(envelopeRing.size());
+            envelopeCount = juce::jmin(envelopeCount + 1, static_cast<int>(envelopeRing.size()));
+
+            std::memmove(streamBuffer.data(), streamBuffer.data() + hopSize,
+                         sizeof(float) * (fftSize - hopSize));
+            streamFill -= hopSize;
+        }
+    }
+}
+
+float BPMDetector::computeFrameFlux(const float* frameData)
+{
+    const float* bins = pipeline.transform(frameData);
+
+    Pipeline::squaredMagnitudes(bins, spectrum);
+    foldToBands(spectrum.data(), fluxBandOfBin, Pipeline::numBins, bandEnergies.data());
+
+    float flux = halfWaveFlux(bandEnergies.data(), streamPrevBands.data(),
+                              bandScratch.data(), numFluxBands);
+
+    juce::FloatVectorOperations::copy(streamPrevBands.data(), bandEnergies.data(), numFluxBands);
+
+    return flux;
+}
+
+float BPMDetector::detectBPMIncremental()
+{
+    // The autocorrelation needs a couple of seconds of envelope before it
+    // says anything trustworthy
+    int minFrames = static_cast<int>(sampleRate * onlineMinSeconds / hopSize);
+
+    if (envelopeCount < minFrames)
+    {
+        confidence = 0.0f;
+        return onlineBPM;
+    }
+
+    // Bound the search to the most recent onlineWindowSeconds and linearize
+    // just that span, oldest first - update cost stays constant no matter
+    // how long the stream has been running
+    int capacity = static_cast<int>(envelopeRing.size());
+    int fullFrames = static_cast<int>(sampleRate * onlineWindowSeconds / hopSize);
+    int windowFrames = juce::jmin(envelopeCount, fullFrames);
+    int oldest = (envelopeRingPos - windowFrames + capacity) % capacity;
+    int firstRun = juce::jmin(windowFrames, capacity - oldest);
+
+    onsetEnvelope.resize(static_cast<size_t>(windowFrames));
+    juce::FloatVectorOperations::copy(onsetEnvelope.data(), envelopeRing.data() + oldest, firstRun);
+    juce::FloatVectorOperations::copy(onsetEnvelope.data() + firstRun, envelopeRing.data(),
+                                      windowFrames - firstRun);
+
+    float rawBPM = finalizeBPM(onsetEnvelope);
+
+    // Smooth toward agreeing estimates; snap only after the raw estimate
+    // has disagreed for several consecutive updates (a real tempo change
+    // rather than one noisy autocorrelation)
+    if (onlineBPM <= 0.0f)
+    {
+        onlineBPM = rawBPM;
+    }
+    else if (std::abs(rawBPM - onlineBPM) < 0.05f * onlineBPM)
+    {
+        onlineBPM = 0.8f * onlineBPM + 0.2f * rawBPM;
+        onlineDisagreeCount = 0;
+    }
+    else if (++onlineDisagreeCount >= 3)
+    {
+        onlineBPM = rawBPM;
+        onlineDisagreeCount = 0;
+    }
+
+    // Early estimates advertise themselves as provisional until the online
+    // window has filled
+    confidence *= juce::jmin(1.0f, static_cast<float>(windowFrames) / static_cast<float>(fullFrames));
+
+    return onlineBPM;
+}
+
+void BPMDetector::resetStream()
+{
+    envelopeRingPos = 0;
+    envelopeCount = 0;
+    streamFill = 0;
+    onlineBPM = 0.0f;
+    onlineDisagreeCount = 0;
+    juce::FloatVectorOperations::clear(streamPrevBands.data(),
+                                       static_cast<int>(streamPrevBands.size()));
+}
+
+void BPMDetector::writeCache(juce::OutputStream& out) const
+{
+    // The most recent online-window span of the envelope plus the running
+    // estimate - enough for the first pass after reload to pick up where
+    // the session left off. The capture rate goes in too: the envelope is
+    // a per-hop stream, so its frame rate is meaningless without it.
+    int capacity = static_cast<int>(envelopeRing.size());
+    int frames = juce::jmin(envelopeCount,
+        static_cast<int>(sampleRate * onlineWindowSeconds / hopSize));
+
+    out.writeFloat(onlineBPM);
+    out.writeFloat(confidence);
+    out.writeDouble(sampleRate);
+    out.writeInt(frames);
+
+    for (int i = 0; i < frames; ++i)
+    {
+        int index = (envelopeRingPos - frames + i + capacity) % capacity;
+        out.writeFloat(envelopeRing[static_cast<size_t>(index)]);
+    }
+}
+
+bool BPMDetector::readCache(juce::InputStream& in)
+{
+    float cachedBPM = in.readFloat();
+    float cachedConfidence = in.readFloat();
+    double cachedRate = in.readDouble();
+    int frames = in.readInt();
+
+    // An envelope captured at another rate has a different frames-per-second
+    // meaning - warm-starting from it would publish a BPM wrong by the rate
+    // ratio, and the online tracker's disagreement snap would hold it for
+    // several further passes. Invalidate instead; the first pass runs cold.
+    if (cachedRate <= 0.0 || std::abs(cachedRate - sampleRate) > 0.5)
+        return false;
+
+    if (frames < 0 || frames > static_cast<int>(cachedRate * maxWindowSeconds / hopSize))
+        return false;
+
+    int capacity = static_cast<int>(envelopeRing.size());
+
+    for (int i = 0; i < frames; ++i)
+    {
+        float value = in.readFloat();
+
+        if (capacity > 0)
+            envelopeRing[static_cast<size_t>(i % capacity)] = value;
+    }
+
+    if (capacity == 0)
+        return false;
+
+    envelopeRingPos = frames % capacity;
+    envelopeCount = juce::jmin(frames, capacity);
+    onlineBPM = cachedBPM;
+    confidence = cachedConfidence;
 
+    return true;
+}
+
+float BPMDetector::finalizeBPM(const std::vector<float>& onsetStrength)
+{
     if (onsetStrength.empty())
         return 0.0f;
 
@@ -58,9 +240,7 @@ void BPMDetector::calculateOnsetStrength(const float* audioData, int numSamples,
 {
     onsetStrength.clear();
 
-    juce::dsp::FFT fft(11); // 2048 point FFT
-    std::vector<std::complex<float>> fftData(fftSize);
-    std::vector<float> prevSpectrum(fftSize / 2, 0.0f);
+    juce::FloatVectorOperations::clear(prevBands.data(), numFluxBands);
 
     int numFrames = (numSamples - fftSize) / hopSize;
 
@@ -68,48 +248,79 @@ void BPMDetector::calculateOnsetStrength(const float* audioData, int numSamples,
     {
         int startSample = frame * hopSize;
 
-        // Apply Hann window
-        auto windowedData = applyHannWindow(audioData + startSample, fftSize);
+        // Windowed real-only transform, then the power spectrum - the
+        // per-bin sqrt is unnecessary, since only relative flux matters
+        // for the tempo autocorrelation
+        const float* bins = pipeline.transform(audioData + startSample);
 
-        // Copy to complex array
-        for (int i = 0; i < fftSize; ++i)
-            fftData[i] = std::complex<float>(windowedData[i], 0.0f);
+        Pipeline::squaredMagnitudes(bins, spectrum);
+        foldToBands(spectrum.data(), fluxBandOfBin, Pipeline::numBins, bandEnergies.data());
 
-        // Perform FFT
-        fft.perform(windowedData.data(), reinterpret_cast<float*>(fftData.data()), false);
+        // Band-compressed spectral flux (onset strength)
+        float flux = halfWaveFlux(bandEnergies.data(), prevBands.data(),
+                                  bandScratch.data(), numFluxBands);
 
-        // Calculate magnitude spectrum
-        std::vector<float> spectrum(fftSize / 2);
-        for (int i = 0; i < fftSize / 2; ++i)
-        {
-            float real = fftData[i].real();
-            float imag = fftData[i].imag();
-            spectrum[i] = std::sqrt(real * real + imag * imag);
-        }
+        onsetStrength.push_back(flux);
+        juce::FloatVectorOperations::copy(prevBands.data(), bandEnergies.data(), numFluxBands);
+    }
+}
 
-        // Calculate spectral flux (onset strength)
-        float flux = 0.0f;
-        for (int i = 0; i < fftSize / 2; ++i)
-        {
-            float diff = spectrum[i] - prevSpectrum[i];
-            if (diff > 0.0f)
-                flux += diff;
-        }
+void BPMDetector::buildFluxBandTable(int numBins, double binHz, std::vector<int>& table)
+{
+    // Geometric band edges from ~40 Hz to Nyquist; bins below the low edge
+    // land in band 0. Only the mapping is precomputed - folding is then a
+    // table-indexed add per bin.
+    double lowHz = 40.0;
+    double highHz = numBins * binHz;
+    double logSpan = std::log(highHz / lowHz);
 
-        onsetStrength.push_back(flux);
-        prevSpectrum = spectrum;
+    table.assign(static_cast<size_t>(numBins), 0);
+
+    for (int bin = 1; bin < numBins; ++bin)
+    {
+        double frequency = bin * binHz;
+
+        if (frequency <= lowHz)
+            continue;
+
+        int band = static_cast<int>(numFluxBands * std::log(frequency / lowHz) / logSpan);
+        table[static_cast<size_t>(bin)] = juce::jlimit(0, numFluxBands - 1, band);
     }
 }
 
+void BPMDetector::foldToBands(const float* spectrum, const std::vector<int>& table,
+                              int numBins, float* bands)
+{
+    juce::FloatVectorOperations::clear(bands, numFluxBands);
+
+    for (int bin = 0; bin < numBins; ++bin)
+        bands[table[static_cast<size_t>(bin)]] += spectrum[bin];
+}
+
+float BPMDetector::halfWaveFlux(const float* spectrum, const float* prevSpectrum,
+                                float* scratch, int numBins)
+{
+    // diff = max(0, spectrum - prevSpectrum), summed. The rectification runs
+    // as vector ops instead of a branch per bin.
+    juce::FloatVectorOperations::subtract(scratch, spectrum, prevSpectrum, numBins);
+    juce::FloatVectorOperations::max(scratch, scratch, 0.0f, numBins);
+
+    float flux = 0.0f;
+    for (int i = 0; i < numBins; ++i)
+        flux += scratch[i];
+
+    return flux;
+}
+
 float BPMDetector::estimateTempoFromOnsets(const std::vector<float>& onsetStrength)
 {
+    tempoHypotheses.clear();
+
     if (onsetStrength.size() < 10)
         return 0.0f;
 
-    // Calculate autocorrelation of onset strength
-    int maxLag = static_cast<int>(onsetStrength.size() / 2);
-    float maxCorr = 0.0f;
-    int bestLag = 0;
+    int numLags = static_cast<int>(onsetStrength.size());
+    int maxLag = numLags / 2;
 
     // Search for tempo in range 40-240 BPM
     float framesPerSecond = static_cast<float>(sampleRate) / hopSize;
@@ -118,51 +329,136 @@ float BPMDetector::estimateTempoFromOnsets(const std::vector<float>& onsetStreng
 
     maxLagRange = juce::jmin(maxLagRange, maxLag);
 
+    if (minLag < 1 || minLag >= maxLagRange)
+        return 0.0f;
+
+    // All lags in one shot
+    computeAutocorrelation(onsetStrength, autocorrValues);
+
+    // Comb-filterbank tempogram: score every candidate lag with decaying
+    // credit from its integer multiples, so the true beat period beats its
+    // octave aliases instead of whichever single lag peaked highest
+    combScores.assign(static_cast<size_t>(maxLagRange), 0.0f);
+
     for (int lag = minLag; lag < maxLagRange; ++lag)
     {
-        float corr = autocorrelate(onsetStrength, lag);
+        float score = 0.0f;
+        float weightSum = 0.0f;
+
+        for (int harmonic = 1; harmonic <= combHarmonics; ++harmonic)
+        {
+            int index = lag * harmonic;
+
+            if (index >= numLags)
+                break;
+
+            float weight = 1.0f / static_cast<float>(harmonic);
+            score += weight * autocorrValues[static_cast<size_t>(index)];
+            weightSum += weight;
+        }
+
+        if (weightSum > 0.0f)
+            combScores[static_cast<size_t>(lag)] = score / weightSum;
+    }
+
+    // Keep the top-K hypotheses, suppressing lags within 5% of one already
+    // taken so the list holds distinct tempi rather than one smeared peak
+    for (int k = 0; k < maxTempoHypotheses; ++k)
+    {
+        float bestScore = 0.0f;
+        int bestLag = 0;
 
-        if (corr > maxCorr)
+        for (int lag = minLag; lag < maxLagRange; ++lag)
         {
-            maxCorr = corr;
-            bestLag = lag;
+            if (combScores[static_cast<size_t>(lag)] > bestScore)
+            {
+                bestScore = combScores[static_cast<size_t>(lag)];
+                bestLag = lag;
+            }
         }
+
+        if (bestLag == 0)
+            break;
+
+        tempoHypotheses.push_back({ framesPerSecond * 60.0f / static_cast<float>(bestLag), bestScore });
+
+        int suppressFrom = juce::jmax(minLag, static_cast<int>(bestLag * 0.95f));
+        int suppressTo = juce::jmin(maxLagRange, static_cast<int>(bestLag * 1.05f) + 1);
+        juce::FloatVectorOperations::clear(combScores.data() + suppressFrom,
+                                           suppressTo - suppressFrom);
     }
 
-    if (bestLag == 0)
+    if (tempoHypotheses.empty())
         return 0.0f;
 
-    // Convert lag to BPM
-    float beatsPerFrame = 1.0f / bestLag;
-    float beatsPerSecond = beatsPerFrame * framesPerSecond;
-    float bpm = beatsPerSecond * 60.0f;
+    // Normalize scores against the winner
+    float topScore = tempoHypotheses.front().score;
+
+    if (topScore > 0.0f)
+        for (auto& hypothesis : tempoHypotheses)
+            hypothesis.score /= topScore;
+
+    // Octave correction: if the winner sits outside the plausible dance
+    // range but a strong runner-up is its half or double, take that instead
+    float bpm = tempoHypotheses.front().bpm;
+
+    if (bpm < 70.0f || bpm > 180.0f)
+    {
+        for (const auto& hypothesis : tempoHypotheses)
+        {
+            float ratio = hypothesis.bpm / bpm;
+            bool octaveRelated = std::abs(ratio - 2.0f) < 0.1f || std::abs(ratio - 0.5f) < 0.025f;
+
+            if (octaveRelated && hypothesis.score >= 0.7f
+                && hypothesis.bpm >= 70.0f && hypothesis.bpm <= 180.0f)
+            {
+                bpm = hypothesis.bpm;
+                break;
+            }
+        }
+    }
 
     return bpm;
 }
 
-float BPMDetector::autocorrelate(const std::vector<float>& signal, int lag)
+void BPMDetector::computeAutocorrelation(const std::vector<float>& signal,
+                                         std::vector<float>& result)
 {
-    float sum = 0.0f;
-    int count = 0;
+    int n = static_cast<int>(signal.size());
 
-    for (size_t i = 0; i < signal.size() - lag; ++i)
+    // Zero-pad to at least 2N so the circular correlation is linear
+    int order = 1;
+    while ((1 << order) < 2 * n)
+        ++order;
+
+    if (autocorrFFT == nullptr || autocorrFFTOrder != order)
     {
-        sum += signal[i] * signal[i + lag];
-        count++;
+        autocorrFFT = FFTBackend::create(order);
+        autocorrFFTOrder = order;
     }
 
-    return count > 0 ? sum / count : 0.0f;
-}
+    int fftLen = 1 << order;
+    autocorrBuffer.assign(static_cast<size_t>(fftLen) * 2, 0.0f);
+    juce::FloatVectorOperations::copy(autocorrBuffer.data(), signal.data(), n);
 
-std::vector<float> BPMDetector::applyHannWindow(const float* data, int size)
-{
-    std::vector<float> windowed(size);
+    // Wiener-Khinchin: FFT, squared magnitude, inverse FFT
+    autocorrFFT->performRealOnlyForward(autocorrBuffer.data());
 
-    for (int i = 0; i < size; ++i)
+    for (int i = 0; i < fftLen; ++i)
     {
-        float window = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (size - 1)));
-        windowed[i] = data[i] * window;
+        float real = autocorrBuffer[2 * i];
+        float imag = autocorrBuffer[2 * i + 1];
+        autocorrBuffer[2 * i] = real * real + imag * imag;
+        autocorrBuffer[2 * i + 1] = 0.0f;
     }
 
-    return windowed;
+    autocorrFFT->performRealOnlyInverse(autocorrBuffer.data());
+
+    // Normalize each lag by its overlap count, matching the per-lag mean
+    // the old O(N*lags) search produced
+    result.resize(static_cast<size_t>(n));
+
+    for (int lag = 0; lag < n; ++lag)
+        result[lag] = autocorrBuffer[lag] / static_cast<float>(n - lag);
 }
+
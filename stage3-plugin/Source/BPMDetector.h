@@ -10,8 +10,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <vector>
-#include <complex>
+
+#include "FFTPipeline.h"
 
 class BPMDetector
 {
@@ -29,24 +31,129 @@ public:
      */
     float detectBPM(const float* audioData, int numSamples);
 
+    /**
+     * Stream newly arrived audio into the persistent onset-envelope ring.
+     * Only the frames covering the new samples are transformed; the envelope
+     * itself is append-only.
+     */
+    void pushAudio(const float* audioData, int numSamples);
+
+    /**
+     * Online tempo estimate: refines a smoothed running BPM over the most
+     * recent few seconds of the streamed envelope, with constant cost per
+     * update. Usable a couple of seconds into the stream instead of after
+     * a full window.
+     */
+    float detectBPMIncremental();
+
+    /** Drops all streamed state (e.g. when analysis restarts). */
+    void resetStream();
+
+    /**
+     * Persists the online tracker state and the recent onset envelope, so
+     * a reloaded session can warm-start instead of rebuilding from silence.
+     */
+    void writeCache(juce::OutputStream& out) const;
+
+    /** Restores state saved by writeCache(). Call after prepare(). */
+    bool readCache(juce::InputStream& in);
+
     float getConfidence() const { return confidence; }
 
+    /** One candidate tempo from the comb-filterbank tempogram. Scores are
+        normalized so the strongest hypothesis is 1.0. */
+    struct TempoHypothesis
+    {
+        float bpm = 0.0f;
+        float score = 0.0f;
+    };
+
+    /** Ranked tempo candidates from the most recent detect pass. */
+    const std::vector<TempoHypothesis>& getTempoHypotheses() const { return tempoHypotheses; }
+
 private:
     double sampleRate = 44100.0;
     float confidence = 0.5f;
 
-    // Analysis parameters
-    static constexpr int hopSize = 512;
-    static constexpr int fftSize = 2048;
+    // Shared windowed-FFT front end; every size is a compile-time constant
+    using Pipeline = FFTPipeline<11>; // 2048-point frames
+    static constexpr int hopSize = Pipeline::hopSize;
+    static constexpr int fftSize = Pipeline::fftSize;
+
+    Pipeline pipeline;
 
     // Helper methods
     void calculateOnsetStrength(const float* audioData, int numSamples,
                                std::vector<float>& onsetStrength);
 
+    float finalizeBPM(const std::vector<float>& onsetStrength);
+
     float estimateTempoFromOnsets(const std::vector<float>& onsetStrength);
 
-    float autocorrelate(const std::vector<float>& signal, int lag);
+    // One-shot autocorrelation over all lags via Wiener-Khinchin
+    // (FFT -> squared magnitude -> inverse FFT), O(N log N) instead of
+    // O(N) per candidate lag
+    void computeAutocorrelation(const std::vector<float>& signal,
+                               std::vector<float>& result);
+
+    // Vectorized kernel for the flux difference
+    static float halfWaveFlux(const float* spectrum, const float* prevSpectrum,
+                             float* scratch, int numBins);
+
+    // Preallocated analysis workspace, sized so a full detect pass performs
+    // no heap allocation
+    static constexpr int maxWindowSeconds = 60; // generous envelope reserve
+
+    std::array<float, Pipeline::numBins> spectrum {};
+    std::vector<float> onsetEnvelope;
+
+    // Band-compressed flux: the spectrum is folded into a few log-spaced
+    // bands before differencing, so the per-frame flux state is a couple
+    // hundred bytes instead of full-resolution vectors - it stays in L1,
+    // and coarse bands are more robust to tonal wobble on percussive input
+    static constexpr int numFluxBands = 32;
+    std::vector<int> fluxBandOfBin;
+    std::array<float, numFluxBands> bandEnergies {};
+    std::array<float, numFluxBands> prevBands {};
+    std::array<float, numFluxBands> bandScratch {};
+
+    static void buildFluxBandTable(int numBins, double binHz, std::vector<int>& table);
+    static void foldToBands(const float* spectrum, const std::vector<int>& table,
+                           int numBins, float* bands);
+
+    // Persistent onset-envelope ring: one flux value per hop, appended as
+    // audio arrives so each update transforms only the new frames while the
+    // tempo search can read an arbitrarily long history
+    std::vector<float> envelopeRing;
+    int envelopeRingPos = 0;
+    int envelopeCount = 0;
+
+    std::array<float, Pipeline::fftSize> streamBuffer {}; // frame assembly for incoming audio
+    int streamFill = 0;
+    std::array<float, numFluxBands> streamPrevBands {};   // flux continuity across pushes
+
+    float computeFrameFlux(const float* frameData);
+
+    // Online tempo tracker: the search window is bounded so updates stay
+    // O(1) however long the stream runs, and the running estimate is
+    // smoothed so one noisy update can't yank the displayed BPM around
+    static constexpr int onlineMinSeconds = 2;    // shortest usable envelope
+    static constexpr int onlineWindowSeconds = 8; // bounded search span
+    float onlineBPM = 0.0f;
+    int onlineDisagreeCount = 0;
+
+    // Autocorrelation state - the plan is cached and only rebuilt when the
+    // padded transform length changes
+    std::unique_ptr<FFTBackend> autocorrFFT;
+    int autocorrFFTOrder = 0;
+    std::vector<float> autocorrBuffer;
+    std::vector<float> autocorrValues;
 
-    // Utility
-    std::vector<float> applyHannWindow(const float* data, int size);
+    // Comb-filterbank tempogram: each candidate lag is scored with decaying
+    // credit from its integer multiples, so the true beat period outscores
+    // its half/double-time aliases even on short windows
+    static constexpr int combHarmonics = 4;
+    static constexpr int maxTempoHypotheses = 4;
+    std::vector<float> combScores;
+    std::vector<TempoHypothesis> tempoHypotheses;
 };
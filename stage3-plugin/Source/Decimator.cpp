@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    FIR Decimator Implementation
+    Windowed-sinc low-pass followed by integer downsampling
+
+  ==============================================================================
+*/
+
+#include "Decimator.h"
+
+void Decimator::prepare(double sr)
+{
+    sourceSampleRate = sr;
+    factor = juce::jmax(1, static_cast<int>(sourceSampleRate / targetSampleRate + 0.5));
+    outputSampleRate = sourceSampleRate / factor;
+
+    if (factor == 1)
+    {
+        coefficients.clear();
+        return;
+    }
+
+    // Hann-windowed sinc low-pass with the cutoff safely below the
+    // decimated Nyquist, normalized to unity DC gain
+    coefficients.resize(numTaps);
+
+    double cutoff = 0.45 / factor; // in cycles per source sample
+    int half = numTaps / 2;
+    double sum = 0.0;
+
+    for (int i = 0; i < numTaps; ++i)
+    {
+        int k = i - half;
+        double sinc = (k == 0)
+            ? 2.0 * cutoff
+            : std::sin(2.0 * juce::MathConstants<double>::pi * cutoff * k)
+                  / (juce::MathConstants<double>::pi * k);
+
+        double hann = 0.5 * (1.0 - std::cos(2.0 * juce::MathConstants<double>::pi * i / (numTaps - 1)));
+
+        coefficients[i] = static_cast<float>(sinc * hann);
+        sum += coefficients[i];
+    }
+
+    for (float& c : coefficients)
+        c = static_cast<float>(c / sum);
+
+    resetStream();
+}
+
+int Decimator::process(const float* input, int numSamples, float* output)
+{
+    if (factor == 1)
+    {
+        juce::FloatVectorOperations::copy(output, input, numSamples);
+        return numSamples;
+    }
+
+    int numOutput = numSamples / factor;
+    int half = numTaps / 2;
+
+    for (int m = 0; m < numOutput; ++m)
+    {
+        int centre = m * factor;
+        int first = juce::jmax(0, centre - half);
+        int last = juce::jmin(numSamples - 1, centre + half);
+
+        float acc = 0.0f;
+        for (int i = first; i <= last; ++i)
+            acc += input[i] * coefficients[i - centre + half];
+
+        output[m] = acc;
+    }
+
+    return numOutput;
+}
+
+int Decimator::processStream(const float* input, int numSamples, float* output)
+{
+    if (factor == 1)
+    {
+        juce::FloatVectorOperations::copy(output, input, numSamples);
+        return numSamples;
+    }
+
+    // Work on history + block so taps can reach across the boundary
+    int historySize = numTaps - 1;
+    streamScratch.resize(static_cast<size_t>(historySize + numSamples));
+    juce::FloatVectorOperations::copy(streamScratch.data(), history.data(), historySize);
+    juce::FloatVectorOperations::copy(streamScratch.data() + historySize, input, numSamples);
+
+    int numOutput = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (++phaseCounter < factor)
+            continue;
+
+        phaseCounter = 0;
+
+        const float* end = streamScratch.data() + historySize + i;
+        float acc = 0.0f;
+
+        for (int k = 0; k < numTaps; ++k)
+            acc += coefficients[k] * end[-k];
+
+        output[numOutput++] = acc;
+    }
+
+    // Keep the scratch tail as history for the next block
+    juce::FloatVectorOperations::copy(history.data(), streamScratch.data() + numSamples, historySize);
+
+    return numOutput;
+}
+
+void Decimator::resetStream()
+{
+    history.assign(static_cast<size_t>(juce::jmax(0, numTaps - 1)), 0.0f);
+    phaseCounter = 0;
+}
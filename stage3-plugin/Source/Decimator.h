@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    FIR Decimator
+    Low-pass + downsample pre-stage for the key-detection path
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+    Decimates audio to roughly 11-12 kHz ahead of key detection. The key
+    detector discards everything above 4186 Hz anyway, so at high session
+    rates most of each full-rate spectrum would be computed and thrown away.
+*/
+class Decimator
+{
+public:
+    Decimator() = default;
+    ~Decimator() = default;
+
+    void prepare(double sourceSampleRate);
+
+    /**
+     * Low-pass and downsample a block of audio.
+     * @param input Pointer to mono audio at the source rate
+     * @param numSamples Number of input samples
+     * @param output Destination, at least getMaxOutputSamples(numSamples)
+     * @return Number of output samples written
+     */
+    int process(const float* input, int numSamples, float* output);
+
+    /**
+     * Streaming variant: keeps numTaps-1 samples of history so the filter
+     * reaches across block boundaries, and tracks the downsampling phase
+     * between calls. Outputs are causal rather than centred.
+     */
+    int processStream(const float* input, int numSamples, float* output);
+
+    /** Clears the streaming history and phase. */
+    void resetStream();
+
+    int getFactor() const { return factor; }
+    double getOutputSampleRate() const { return outputSampleRate; }
+
+    /** Worst-case output count for a block of input. processStream can emit
+        ceil(numSamples / factor) when its carried phase lines up, so this
+        rounds up - sizing a destination from a floored division overflows
+        whenever the block length isn't a multiple of the factor. */
+    int getMaxOutputSamples(int numInputSamples) const { return (numInputSamples + factor - 1) / factor; }
+
+private:
+    // Aim just above double the top of the musical range (4186 Hz)
+    static constexpr double targetSampleRate = 12000.0;
+    static constexpr int numTaps = 63;
+
+    double sourceSampleRate = 44100.0;
+    double outputSampleRate = 44100.0;
+    int factor = 1;
+
+    std::vector<float> coefficients; // windowed-sinc low-pass, unity DC gain
+
+    // Streaming state
+    std::vector<float> history;       // last numTaps-1 input samples
+    std::vector<float> streamScratch; // history + current block, contiguous
+    int phaseCounter = 0;             // input samples since the last output
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Decimator)
+};
@@ -0,0 +1,337 @@
+/*
+  ==============================================================================
+
+    FFT Backend Implementations
+    juce::dsp::FFT reference plus optional vDSP / FFTW backends and a
+    cross-check wrapper, chosen by the build flags in the .jucer
+
+  ==============================================================================
+*/
+
+#include "FFTBackend.h"
+
+#ifndef BPMKEY_USE_VDSP
+ #define BPMKEY_USE_VDSP 0
+#endif
+
+#ifndef BPMKEY_USE_FFTW
+ #define BPMKEY_USE_FFTW 0
+#endif
+
+#ifndef BPMKEY_FFT_CROSSCHECK
+ #define BPMKEY_FFT_CROSSCHECK 0
+#endif
+
+#if BPMKEY_USE_VDSP && ! (JUCE_MAC || JUCE_IOS)
+ #error "BPMKEY_USE_VDSP requires an Apple target"
+#endif
+
+#if BPMKEY_USE_VDSP
+ #include <Accelerate/Accelerate.h>
+#endif
+
+#if BPMKEY_USE_FFTW
+ #include <fftw3.h>
+ #include <complex>
+#endif
+
+namespace
+{
+
+//==============================================================================
+/** Always-available reference backend, delegating to juce::dsp::FFT. */
+class JuceFFTBackend : public FFTBackend
+{
+public:
+    explicit JuceFFTBackend(int orderToUse) : fft(orderToUse) {}
+
+    const char* getName() const override { return "juce"; }
+
+    void performRealOnlyForward(float* data) override
+    {
+        fft.performRealOnlyForwardTransform(data);
+    }
+
+    void performRealOnlyInverse(float* data) override
+    {
+        fft.performRealOnlyInverseTransform(data);
+    }
+
+private:
+    juce::dsp::FFT fft;
+};
+
+#if BPMKEY_USE_VDSP
+//==============================================================================
+/**
+    Accelerate backend. vDSP's packed split-complex real transform is
+    several times faster than the JUCE fallback at our sizes; the extra
+    work here is repacking its output into the full conjugate-symmetric
+    interleaved layout the callers were written against.
+*/
+class VDSPBackend : public FFTBackend
+{
+public:
+    explicit VDSPBackend(int orderToUse)
+        : order(static_cast<vDSP_Length>(orderToUse)),
+          size(1 << orderToUse),
+          setup(vDSP_create_fftsetup(order, kFFTRadix2)),
+          splitRe(static_cast<size_t>(size / 2)),
+          splitIm(static_cast<size_t>(size / 2))
+    {
+        jassert(setup != nullptr);
+    }
+
+    ~VDSPBackend() override
+    {
+        vDSP_destroy_fftsetup(setup);
+    }
+
+    const char* getName() const override { return "vdsp"; }
+
+    void performRealOnlyForward(float* data) override
+    {
+        DSPSplitComplex split { splitRe.data(), splitIm.data() };
+        auto halfLength = static_cast<vDSP_Length>(size / 2);
+
+        vDSP_ctoz(reinterpret_cast<const DSPComplex*>(data), 2, &split, 1, halfLength);
+        vDSP_fft_zrip(setup, &split, 1, order, kFFTDirection_Forward);
+
+        // zrip produces 2x the DFT values; halve first so the unpacked
+        // spectrum matches the JUCE reference bit-for-bit in scale
+        float half = 0.5f;
+        vDSP_vsmul(split.realp, 1, &half, split.realp, 1, halfLength);
+        vDSP_vsmul(split.imagp, 1, &half, split.imagp, 1, halfLength);
+
+        float dc = split.realp[0];
+        float nyquist = split.imagp[0];
+
+        // Unpack to the full interleaved spectrum, mirroring the upper
+        // half by conjugate symmetry
+        data[0] = dc;
+        data[1] = 0.0f;
+        data[static_cast<size_t>(size)] = nyquist;
+        data[static_cast<size_t>(size) + 1] = 0.0f;
+
+        for (int k = 1; k < size / 2; ++k)
+        {
+            float re = split.realp[k];
+            float im = split.imagp[k];
+
+            data[static_cast<size_t>(2 * k)] = re;
+            data[static_cast<size_t>(2 * k) + 1] = im;
+            data[static_cast<size_t>(2 * (size - k))] = re;
+            data[static_cast<size_t>(2 * (size - k)) + 1] = -im;
+        }
+    }
+
+    void performRealOnlyInverse(float* data) override
+    {
+        // Repack the lower spectrum half into vDSP's packed format (DC and
+        // Nyquist share the first complex slot, doubled for zrip scaling)
+        splitRe[0] = 2.0f * data[0];
+        splitIm[0] = 2.0f * data[static_cast<size_t>(size)];
+
+        for (int k = 1; k < size / 2; ++k)
+        {
+            splitRe[static_cast<size_t>(k)] = 2.0f * data[static_cast<size_t>(2 * k)];
+            splitIm[static_cast<size_t>(k)] = 2.0f * data[static_cast<size_t>(2 * k) + 1];
+        }
+
+        DSPSplitComplex split { splitRe.data(), splitIm.data() };
+        auto halfLength = static_cast<vDSP_Length>(size / 2);
+
+        vDSP_fft_zrip(setup, &split, 1, order, kFFTDirection_Inverse);
+
+        // Inverse zrip of exact DFT values yields 2 * size * signal; the
+        // JUCE reference normalizes by 1/size, so scale by 1/(2 * size)
+        float scale = 1.0f / (2.0f * static_cast<float>(size));
+        vDSP_vsmul(split.realp, 1, &scale, split.realp, 1, halfLength);
+        vDSP_vsmul(split.imagp, 1, &scale, split.imagp, 1, halfLength);
+
+        vDSP_ztoc(&split, 1, reinterpret_cast<DSPComplex*>(data), 2, halfLength);
+    }
+
+private:
+    vDSP_Length order;
+    int size;
+    FFTSetup setup;
+    std::vector<float> splitRe, splitIm;
+};
+#endif // BPMKEY_USE_VDSP
+
+#if BPMKEY_USE_FFTW
+//==============================================================================
+/**
+    FFTW backend for the Linux render boxes. fftwf_execute is thread-safe
+    against instance-owned plans and buffers (one FFTPipeline per
+    detector), but the planner itself is not: backends are constructed
+    concurrently - the batch CLI builds detectors per file across the
+    pool, and plugin instances prepare in parallel - so plan creation and
+    destruction are serialized through a process-wide lock.
+*/
+class FFTWBackend : public FFTBackend
+{
+public:
+    explicit FFTWBackend(int orderToUse)
+        : size(1 << orderToUse),
+          real(static_cast<size_t>(size)),
+          complexOut(static_cast<size_t>(size / 2 + 1))
+    {
+        const juce::ScopedLock sl(getPlannerLock());
+
+        forwardPlan = fftwf_plan_dft_r2c_1d(size, real.data(),
+                                            reinterpret_cast<fftwf_complex*>(complexOut.data()),
+                                            FFTW_MEASURE);
+        inversePlan = fftwf_plan_dft_c2r_1d(size,
+                                            reinterpret_cast<fftwf_complex*>(complexOut.data()),
+                                            real.data(), FFTW_MEASURE);
+    }
+
+    ~FFTWBackend() override
+    {
+        const juce::ScopedLock sl(getPlannerLock());
+
+        fftwf_destroy_plan(forwardPlan);
+        fftwf_destroy_plan(inversePlan);
+    }
+
+    const char* getName() const override { return "fftw"; }
+
+    void performRealOnlyForward(float* data) override
+    {
+        juce::FloatVectorOperations::copy(real.data(), data, size);
+        fftwf_execute(forwardPlan);
+
+        // r2c gives the lower half plus Nyquist; mirror the rest
+        for (int k = 0; k <= size / 2; ++k)
+        {
+            data[static_cast<size_t>(2 * k)] = complexOut[static_cast<size_t>(k)].real();
+            data[static_cast<size_t>(2 * k) + 1] = complexOut[static_cast<size_t>(k)].imag();
+        }
+
+        for (int k = 1; k < size / 2; ++k)
+        {
+            data[static_cast<size_t>(2 * (size - k))] = complexOut[static_cast<size_t>(k)].real();
+            data[static_cast<size_t>(2 * (size - k)) + 1] = -complexOut[static_cast<size_t>(k)].imag();
+        }
+    }
+
+    void performRealOnlyInverse(float* data) override
+    {
+        for (int k = 0; k <= size / 2; ++k)
+            complexOut[static_cast<size_t>(k)] = { data[static_cast<size_t>(2 * k)],
+                                                   data[static_cast<size_t>(2 * k) + 1] };
+
+        fftwf_execute(inversePlan);
+
+        // c2r is unnormalized; the JUCE reference scales by 1/size
+        juce::FloatVectorOperations::copyWithMultiply(data, real.data(),
+                                                      1.0f / static_cast<float>(size), size);
+    }
+
+private:
+    static juce::CriticalSection& getPlannerLock()
+    {
+        static juce::CriticalSection plannerLock;
+        return plannerLock;
+    }
+
+    int size;
+    std::vector<float> real;
+    std::vector<std::complex<float>> complexOut;
+    fftwf_plan forwardPlan, inversePlan;
+};
+#endif // BPMKEY_USE_FFTW
+
+#if BPMKEY_FFT_CROSSCHECK
+//==============================================================================
+/**
+    Correctness harness: runs every call through both the selected backend
+    and the JUCE reference and asserts when the outputs diverge beyond
+    float rounding. Strictly a debugging configuration - it more than
+    doubles transform cost.
+*/
+class CrossCheckBackend : public FFTBackend
+{
+public:
+    CrossCheckBackend(std::unique_ptr<FFTBackend> primaryToUse, int orderToUse)
+        : primary(std::move(primaryToUse)),
+          reference(orderToUse),
+          size(1 << orderToUse),
+          referenceBuffer(static_cast<size_t>(size) * 2)
+    {}
+
+    const char* getName() const override { return primary->getName(); }
+
+    void performRealOnlyForward(float* data) override
+    {
+        juce::FloatVectorOperations::copy(referenceBuffer.data(), data, size * 2);
+
+        primary->performRealOnlyForward(data);
+        reference.performRealOnlyForwardTransform(referenceBuffer.data());
+
+        compare(data, size * 2);
+    }
+
+    void performRealOnlyInverse(float* data) override
+    {
+        juce::FloatVectorOperations::copy(referenceBuffer.data(), data, size * 2);
+
+        primary->performRealOnlyInverse(data);
+        reference.performRealOnlyInverseTransform(referenceBuffer.data());
+
+        compare(data, size);
+    }
+
+private:
+    void compare(const float* produced, int numValues) const
+    {
+        // Tolerance is relative to the largest value in the frame - the
+        // backends order their butterflies differently, so bit-exact
+        // agreement is not expected, but disagreement past float rounding
+        // means a packing or scaling bug
+        float peak = 1.0e-6f;
+        for (int i = 0; i < numValues; ++i)
+            peak = juce::jmax(peak, std::abs(referenceBuffer[static_cast<size_t>(i)]));
+
+        float worst = 0.0f;
+        for (int i = 0; i < numValues; ++i)
+            worst = juce::jmax(worst, std::abs(produced[i] - referenceBuffer[static_cast<size_t>(i)]));
+
+        if (worst > peak * 1.0e-4f)
+        {
+            DBG("FFT cross-check failed for backend '" << primary->getName()
+                << "': max deviation " << (worst / peak) << " of peak");
+            jassertfalse;
+        }
+    }
+
+    std::unique_ptr<FFTBackend> primary;
+    juce::dsp::FFT reference;
+    int size;
+    std::vector<float> referenceBuffer;
+};
+#endif // BPMKEY_FFT_CROSSCHECK
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<FFTBackend> FFTBackend::create(int order)
+{
+    std::unique_ptr<FFTBackend> backend;
+
+   #if BPMKEY_USE_VDSP
+    backend = std::make_unique<VDSPBackend>(order);
+   #elif BPMKEY_USE_FFTW
+    backend = std::make_unique<FFTWBackend>(order);
+   #else
+    backend = std::make_unique<JuceFFTBackend>(order);
+   #endif
+
+   #if BPMKEY_FFT_CROSSCHECK
+    backend = std::make_unique<CrossCheckBackend>(std::move(backend), order);
+   #endif
+
+    return backend;
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    FFT Backend Abstraction
+    Thin interface over the platform's fastest real transform, selected at
+    build time via preprocessor flags
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+
+/**
+    Backend interface for the real-only transforms the detectors run. The
+    data layout matches juce::dsp::FFT's real-only calls: the caller hands
+    in 2 * fftSize floats, the forward transform leaves the full
+    conjugate-symmetric interleaved spectrum in place, and the inverse
+    restores the 1/fftSize-scaled signal in the first fftSize floats.
+
+    The implementation is a build-time choice in the .jucer configurations:
+
+      (default)                juce::dsp::FFT
+      BPMKEY_USE_VDSP=1        Apple Accelerate vDSP (macOS/iOS)
+      BPMKEY_USE_FFTW=1        FFTW3, single precision
+      BPMKEY_FFT_CROSSCHECK=1  run the selected backend against the JUCE
+                               reference on every call and assert on
+                               divergence (debugging builds only)
+*/
+class FFTBackend
+{
+public:
+    virtual ~FFTBackend() = default;
+
+    virtual const char* getName() const = 0;
+
+    virtual void performRealOnlyForward(float* data) = 0;
+    virtual void performRealOnlyInverse(float* data) = 0;
+
+    /** Creates the backend the build flags select, for 2^order points. */
+    static std::unique_ptr<FFTBackend> create(int order);
+};
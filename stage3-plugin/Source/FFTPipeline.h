@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    Compile-Time FFT Pipeline
+    Windowed real-only transform front end shared by the detectors,
+    templated on FFT order and hop size
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "FFTBackend.h"
+
+/**
+    Windowed real-only FFT front end with every size a compile-time
+    constant. Frame buffers are fixed-size arrays the compiler can unroll
+    and vectorize against instead of runtime-sized vectors, and the two
+    detectors stop duplicating fftOrder/fftSize/hopSize definitions.
+    Instantiated at order 11 (BPM) and order 12 (key).
+*/
+template <int FFTOrder, int HopSizeParam = 512>
+class FFTPipeline
+{
+public:
+    static constexpr int fftOrder = FFTOrder;
+    static constexpr int fftSize = 1 << FFTOrder;
+    static constexpr int hopSize = HopSizeParam;
+    static constexpr int numBins = fftSize / 2;
+
+    FFTPipeline()
+    {
+        // Hann table, built once per instance. std::cos is not constexpr at
+        // our language level, so the table can't be a compile-time constant -
+        // but the fixed extent is what the optimizer actually needs.
+        for (int i = 0; i < fftSize; ++i)
+            window[static_cast<size_t>(i)] = 0.5f * (1.0f - std::cos(
+                juce::MathConstants<float>::twoPi * static_cast<float>(i) / (fftSize - 1)));
+    }
+
+    /**
+     * Windows one fftSize frame and runs the real-only forward transform,
+     * leaving interleaved complex bins in the internal workspace.
+     */
+    const float* transform(const float* frameData)
+    {
+        juce::FloatVectorOperations::multiply(fftBuffer.data(), frameData,
+                                              window.data(), fftSize);
+        juce::FloatVectorOperations::clear(fftBuffer.data() + fftSize, fftSize);
+
+        fft->performRealOnlyForward(fftBuffer.data());
+
+        return fftBuffer.data();
+    }
+
+    /**
+     * Power spectrum of interleaved complex bins into a fixed-size array.
+     * Branch- and sqrt-free with a compile-time trip count.
+     */
+    static void squaredMagnitudes(const float* interleavedComplex,
+                                  std::array<float, numBins>& magnitudes)
+    {
+        for (int i = 0; i < numBins; ++i)
+        {
+            float real = interleavedComplex[2 * i];
+            float imag = interleavedComplex[2 * i + 1];
+            magnitudes[static_cast<size_t>(i)] = real * real + imag * imag;
+        }
+    }
+
+    const std::array<float, fftSize>& getWindow() const { return window; }
+
+private:
+    // Build-time-selected transform (vDSP / FFTW / JUCE fallback)
+    std::unique_ptr<FFTBackend> fft { FFTBackend::create(fftOrder) };
+    std::array<float, fftSize> window {};
+    std::array<float, fftSize * 2> fftBuffer {};
+};
@@ -9,9 +9,40 @@
 
 #include "KeyDetector.h"
 
-void KeyDetector::prepare(double sr)
+#include <algorithm>
+#include <cstring>
+
+void KeyDetector::prepare(double sr, double slidingWindowSeconds)
 {
     sampleRate = sr;
+
+    // Sliding-window state for the incremental path - the frame assembly
+    // buffer and transform workspace are fixed-size members now
+    maxWindowFrames = juce::jmax(1, static_cast<int>(sampleRate * slidingWindowSeconds / hopSize));
+    frameChroma.assign(static_cast<size_t>(maxWindowFrames) * 12, 0.0f);
+    resetStream();
+
+    buildProfileMatrix();
+
+    // Precompute the pitch class of every bin and the span of bins inside
+    // the musical range (roughly 27.5 Hz to 4186 Hz)
+    binPitchClass.assign(fftSize / 2, 0);
+    firstMusicalBin = fftSize / 2;
+    lastMusicalBin = 0;
+
+    float binHz = static_cast<float>(sampleRate) / fftSize;
+
+    for (int bin = 1; bin < fftSize / 2; ++bin)
+    {
+        float frequency = bin * binHz;
+
+        if (frequency < 27.5f || frequency > 4186.0f)
+            continue;
+
+        binPitchClass[bin] = static_cast<int>(frequencyToPitchClass(frequency)) % 12;
+        firstMusicalBin = juce::jmin(firstMusicalBin, bin);
+        lastMusicalBin = bin + 1;
+    }
 }
 
 std::tuple<juce::String, juce::String, float> KeyDetector::detectKey(
@@ -24,6 +55,12 @@ std::tuple<juce::String, juce::String, float> KeyDetector::detectKey(
     std::array<float, 12> chromagram = {0};
     calculateChromagram(audioData, numSamples, chromagram);
 
+    auto result = finalizeKey(chromagram);
+    return { result.keyName(), result.modeName(), result.confidence };
+}
+
+KeyDetector::Result KeyDetector::finalizeKey(std::array<float, 12>& chromagram)
+{
     // Normalize chromagram
     float sum = 0.0f;
     for (float val : chromagram)
@@ -44,130 +81,266 @@ void KeyDetector::calculateChromagram(const float* audioData, int numSamples,
 {
     chromagram.fill(0.0f);
 
-    juce::dsp::FFT fft(12); // 4096 point FFT
-    std::vector<std::complex<float>> fftData(fftSize);
-
     int numFrames = (numSamples - fftSize) / hopSize;
+    std::array<float, 12> frameContribution;
 
     for (int frame = 0; frame < numFrames; ++frame)
     {
-        int startSample = frame * hopSize;
+        computeFrameChroma(audioData + frame * hopSize, frameContribution);
 
-        // Apply Hann window
-        std::vector<float> windowed(fftSize);
-        for (int i = 0; i < fftSize; ++i)
-        {
-            float window = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (fftSize - 1)));
-            windowed[i] = audioData[startSample + i] * window;
-        }
+        for (int i = 0; i < 12; ++i)
+            chromagram[i] += frameContribution[i];
+    }
+}
 
-        // Perform FFT
-        fft.perform(windowed.data(), reinterpret_cast<float*>(fftData.data()), false);
+void KeyDetector::computeFrameChroma(const float* frameData, std::array<float, 12>& chroma)
+{
+    chroma.fill(0.0f);
 
-        // Map FFT bins to pitch classes
-        for (int bin = 1; bin < fftSize / 2; ++bin)
-        {
-            float frequency = bin * static_cast<float>(sampleRate) / fftSize;
+    // Windowed real-only transform, interleaved complex bins out
+    const float* bins = pipeline.transform(frameData);
 
-            // Skip frequencies outside musical range (roughly 27.5 Hz to 4186 Hz)
-            if (frequency < 27.5f || frequency > 4186.0f)
-                continue;
+    // Map FFT bins to pitch classes via the precomputed table
+    for (int bin = firstMusicalBin; bin < lastMusicalBin; ++bin)
+    {
+        float real = bins[2 * bin];
+        float imag = bins[2 * bin + 1];
+        float magnitude = std::sqrt(real * real + imag * imag);
 
-            // Get magnitude
-            float real = fftData[bin].real();
-            float imag = fftData[bin].imag();
-            float magnitude = std::sqrt(real * real + imag * imag);
+        chroma[binPitchClass[bin]] += magnitude;
+    }
+}
+
+void KeyDetector::pushAudio(const float* audioData, int numSamples)
+{
+    std::array<float, 12> chroma;
+    int pos = 0;
 
-            // Map to pitch class (0-11)
-            float pitchClass = frequencyToPitchClass(frequency);
-            int pitchClassIndex = static_cast<int>(pitchClass) % 12;
+    while (pos < numSamples)
+    {
+        int toCopy = juce::jmin(numSamples - pos, fftSize - streamFill);
+        juce::FloatVectorOperations::copy(streamBuffer.data() + streamFill,
+                                          audioData + pos, toCopy);
+        streamFill += toCopy;
+        pos += toCopy;
 
-            chromagram[pitchClassIndex] += magnitude;
+        if (streamFill == fftSize)
+        {
+            computeFrameChroma(streamBuffer.data(), chroma);
+            pushFrameChroma(chroma);
+
+            // Slide the assembly buffer forward by one hop
+            std::memmove(streamBuffer.data(), streamBuffer.data() + hopSize,
+                         sizeof(float) * (fftSize - hopSize));
+            streamFill -= hopSize;
         }
     }
 }
 
-std::tuple<juce::String, juce::String, float> KeyDetector::findBestKey(
-    const std::array<float, 12>& pitchClassDistribution)
+void KeyDetector::pushFrameChroma(const std::array<float, 12>& chroma)
 {
-    float maxCorrelation = -1.0f;
-    juce::String bestKey = "C";
-    juce::String bestMode = "major";
+    float* slot = frameChroma.data() + static_cast<size_t>(frameRingPos) * 12;
 
-    // Try all 12 keys in both major and minor
-    for (int root = 0; root < 12; ++root)
+    // Subtract the expired frame this slot held, then add the new one
+    if (framesInRing == maxWindowFrames)
     {
-        // Rotate profiles to match this root
-        std::array<float, 12> rotatedMajor;
-        std::array<float, 12> rotatedMinor;
-
         for (int i = 0; i < 12; ++i)
-        {
-            rotatedMajor[i] = majorProfile[(i + root) % 12];
-            rotatedMinor[i] = minorProfile[(i + root) % 12];
-        }
+            chromaSum[i] -= slot[i];
+    }
+    else
+    {
+        ++framesInRing;
+    }
 
-        // Calculate correlations
-        float majorCorr = correlation(pitchClassDistribution, rotatedMajor);
-        float minorCorr = correlation(pitchClassDistribution, rotatedMinor);
+    for (int i = 0; i < 12; ++i)
+    {
+        slot[i] = chroma[i];
+        chromaSum[i] += chroma[i];
+    }
 
-        // Check if major key is best so far
-        if (majorCorr > maxCorrelation)
-        {
-            maxCorrelation = majorCorr;
-            bestKey = pitchClasses[root];
-            bestMode = "major";
-        }
+    frameRingPos = (frameRingPos + 1) % maxWindowFrames;
+}
 
-        // Check if minor key is best so far
-        if (minorCorr > maxCorrelation)
-        {
-            maxCorrelation = minorCorr;
-            bestKey = pitchClasses[root];
-            bestMode = "minor";
-        }
+KeyDetector::Result KeyDetector::detectKeyIncremental()
+{
+    if (framesInRing == 0)
+        return {};
+
+    std::array<float, 12> chromagram;
+    float sum = 0.0f;
+
+    for (int i = 0; i < 12; ++i)
+    {
+        chromagram[i] = static_cast<float>(chromaSum[i]);
+        sum += chromagram[i];
     }
 
-    // Normalize correlation to 0-1 confidence
-    float confidence = (maxCorrelation + 1.0f) / 2.0f;
-    confidence = juce::jlimit(0.0f, 1.0f, confidence);
+    if (sum > 0.0f)
+        for (float& val : chromagram)
+            val /= sum;
+
+    // The window advances by a handful of frames per tick, so most ticks
+    // the sum-normalized chromagram is all but identical to the one the
+    // last search ran on - return the cached result instead of searching
+    if (lastSearchValid && lastSearchResult.confidence > 0.0f)
+    {
+        float maxDiff = 0.0f;
+        for (int i = 0; i < 12; ++i)
+            maxDiff = juce::jmax(maxDiff, std::abs(chromagram[i] - lastSearchChroma[i]));
 
-    return {bestKey, bestMode, confidence};
+        if (maxDiff < chromaChangeEpsilon)
+            return lastSearchResult;
+    }
+
+    lastSearchChroma = chromagram;
+    lastSearchResult = findBestKey(chromagram);
+    lastSearchValid = true;
+
+    return lastSearchResult;
+}
+
+void KeyDetector::resetStream()
+{
+    chromaSum.fill(0.0);
+    frameRingPos = 0;
+    framesInRing = 0;
+    streamFill = 0;
+    lastSearchValid = false;
 }
 
-float KeyDetector::correlation(const std::array<float, 12>& x, const std::array<float, 12>& y)
+void KeyDetector::writeCache(juce::OutputStream& out) const
 {
-    // Calculate means
-    float meanX = 0.0f, meanY = 0.0f;
+    out.writeInt(framesInRing);
+
     for (int i = 0; i < 12; ++i)
+        out.writeDouble(chromaSum[static_cast<size_t>(i)]);
+}
+
+bool KeyDetector::readCache(juce::InputStream& in)
+{
+    int frames = in.readInt();
+    std::array<double, 12> cachedSum;
+
+    for (int i = 0; i < 12; ++i)
+        cachedSum[static_cast<size_t>(i)] = in.readDouble();
+
+    if (frames <= 0 || maxWindowFrames <= 0)
+        return false;
+
+    // Seed the ring with the average cached frame, scaled down if the ring
+    // is smaller than the saved window, so the restored energy expires
+    // naturally as fresh frames arrive
+    resetStream();
+
+    framesInRing = juce::jmin(frames, maxWindowFrames);
+    frameRingPos = framesInRing % maxWindowFrames;
+
+    double scale = static_cast<double>(framesInRing) / frames;
+
+    for (int i = 0; i < 12; ++i)
+        chromaSum[static_cast<size_t>(i)] = cachedSum[static_cast<size_t>(i)] * scale;
+
+    for (int frame = 0; frame < framesInRing; ++frame)
+    {
+        float* slot = frameChroma.data() + static_cast<size_t>(frame) * 12;
+
+        for (int i = 0; i < 12; ++i)
+            slot[i] = static_cast<float>(chromaSum[static_cast<size_t>(i)] / framesInRing);
+    }
+
+    return true;
+}
+
+void KeyDetector::buildProfileMatrix()
+{
+    std::array<float, 12> rotated;
+    std::array<float, 12> normalized;
+
+    for (int root = 0; root < 12; ++root)
     {
-        meanX += x[i];
-        meanY += y[i];
+        for (int i = 0; i < 12; ++i)
+            rotated[i] = majorProfile[(i + root) % 12];
+
+        zscoreNormalize(rotated, normalized);
+        std::copy(normalized.begin(), normalized.end(),
+                  profileMatrix.begin() + static_cast<size_t>(root) * 12);
+
+        for (int i = 0; i < 12; ++i)
+            rotated[i] = minorProfile[(i + root) % 12];
+
+        zscoreNormalize(rotated, normalized);
+        std::copy(normalized.begin(), normalized.end(),
+                  profileMatrix.begin() + static_cast<size_t>(12 + root) * 12);
     }
-    meanX /= 12.0f;
-    meanY /= 12.0f;
+}
+
+void KeyDetector::zscoreNormalize(const std::array<float, 12>& in, std::array<float, 12>& out)
+{
+    float mean = 0.0f;
+    for (float val : in)
+        mean += val;
+    mean /= 12.0f;
 
-    // Calculate standard deviations and covariance
-    float stdX = 0.0f, stdY = 0.0f, covariance = 0.0f;
+    float norm = 0.0f;
     for (int i = 0; i < 12; ++i)
     {
-        float dx = x[i] - meanX;
-        float dy = y[i] - meanY;
+        out[i] = in[i] - mean;
+        norm += out[i] * out[i];
+    }
 
-        stdX += dx * dx;
-        stdY += dy * dy;
-        covariance += dx * dy;
+    // A flat vector has no key preference; zero it so every dot product
+    // against it scores 0, matching the old correlation() guard
+    if (norm < 1.0e-10f)
+    {
+        out.fill(0.0f);
+        return;
     }
 
-    stdX = std::sqrt(stdX);
-    stdY = std::sqrt(stdY);
+    float invNorm = 1.0f / std::sqrt(norm);
+    for (float& val : out)
+        val *= invNorm;
+}
 
-    // Avoid division by zero
-    if (stdX < 1e-10f || stdY < 1e-10f)
-        return 0.0f;
+KeyDetector::Result KeyDetector::findBestKey(
+    const std::array<float, 12>& pitchClassDistribution)
+{
+    // With both sides z-score-normalized, Pearson correlation is a dot
+    // product: the 24-way search is one matrix-vector product against the
+    // precomputed profile matrix, no per-candidate rotation or statistics
+    std::array<float, 12> z;
+    zscoreNormalize(pitchClassDistribution, z);
+
+    float maxCorrelation = -1.0f;
+    int bestCandidate = 0;
 
-    // Return Pearson correlation coefficient
-    return covariance / (stdX * stdY);
+    for (int candidate = 0; candidate < numKeyCandidates; ++candidate)
+    {
+        const float* row = profileMatrix.data() + static_cast<size_t>(candidate) * 12;
+
+        float score = 0.0f;
+        for (int i = 0; i < 12; ++i)
+            score += row[i] * z[i];
+
+        if (score > maxCorrelation)
+        {
+            maxCorrelation = score;
+            bestCandidate = candidate;
+        }
+    }
+
+    Result best;
+    best.pitchClass = bestCandidate % 12;
+    best.isMinor = bestCandidate >= 12;
+
+    // Normalize correlation to 0-1 confidence
+    best.confidence = juce::jlimit(0.0f, 1.0f, (maxCorrelation + 1.0f) / 2.0f);
+
+    return best;
+}
+
+const char* KeyDetector::getPitchClassName(int pitchClass)
+{
+    return pitchClasses[((pitchClass % 12) + 12) % 12];
 }
 
 float KeyDetector::frequencyToPitchClass(float frequency)
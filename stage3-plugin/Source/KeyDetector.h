@@ -14,13 +14,32 @@
 #include <tuple>
 #include <array>
 
+#include "FFTPipeline.h"
+
 class KeyDetector
 {
 public:
     KeyDetector() = default;
     ~KeyDetector() = default;
 
-    void prepare(double sampleRate);
+    /**
+     * Compact key estimate: pitch class index plus mode flag, so results
+     * can be published atomically and turned into strings only when shown.
+     */
+    struct Result
+    {
+        int pitchClass = 0;
+        bool isMinor = false;
+        float confidence = 0.0f;
+
+        juce::String keyName() const  { return getPitchClassName(pitchClass); }
+        juce::String modeName() const { return isMinor ? "minor" : "major"; }
+    };
+
+    /** Display name ("C", "C#", ...) for a pitch class index 0-11. */
+    static const char* getPitchClassName(int pitchClass);
+
+    void prepare(double sampleRate, double slidingWindowSeconds = 10.0);
 
     /**
      * Detect musical key from audio buffer
@@ -30,6 +49,28 @@ public:
      */
     std::tuple<juce::String, juce::String, float> detectKey(const float* audioData, int numSamples);
 
+    /**
+     * Stream newly arrived audio into the sliding-window chromagram. Only
+     * the frames covering the new samples are computed; expired frames are
+     * subtracted from the running accumulation.
+     */
+    void pushAudio(const float* audioData, int numSamples);
+
+    /** Key estimate over the sliding window maintained by pushAudio(). */
+    Result detectKeyIncremental();
+
+    /** Drops all streamed state (e.g. when analysis restarts). */
+    void resetStream();
+
+    /**
+     * Persists the sliding-window chromagram accumulation, so a reloaded
+     * session can warm-start instead of rebuilding from silence.
+     */
+    void writeCache(juce::OutputStream& out) const;
+
+    /** Restores state saved by writeCache(). Call after prepare(). */
+    bool readCache(juce::InputStream& in);
+
 private:
     double sampleRate = 44100.0;
 
@@ -48,19 +89,61 @@ private:
         "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
     };
 
-    // Analysis parameters
-    static constexpr int hopSize = 512;
-    static constexpr int fftSize = 4096;
+    // Shared windowed-FFT front end; every size is a compile-time constant
+    using Pipeline = FFTPipeline<12>; // 4096-point frames
+    static constexpr int hopSize = Pipeline::hopSize;
+    static constexpr int fftSize = Pipeline::fftSize;
     static constexpr int numBins = 12; // Chromagram bins
 
+    Pipeline pipeline;
+
     // Helper methods
     void calculateChromagram(const float* audioData, int numSamples,
                             std::array<float, 12>& chromagram);
 
-    std::tuple<juce::String, juce::String, float> findBestKey(
-        const std::array<float, 12>& pitchClassDistribution);
+    Result finalizeKey(std::array<float, 12>& chromagram);
 
-    float correlation(const std::array<float, 12>& x, const std::array<float, 12>& y);
+    Result findBestKey(const std::array<float, 12>& pitchClassDistribution);
 
     float frequencyToPitchClass(float frequency);
+
+    // All 24 rotated key profiles (12 major roots, then 12 minor),
+    // z-score-normalized so Pearson correlation against the equally
+    // normalized chromagram collapses to a plain dot product. Built once
+    // in prepare(); the search is then one 24x12 matrix-vector product.
+    static constexpr int numKeyCandidates = 24;
+    std::array<float, numKeyCandidates * 12> profileMatrix {};
+
+    void buildProfileMatrix();
+
+    /** Removes the mean and scales to unit norm (zeros a flat input). */
+    static void zscoreNormalize(const std::array<float, 12>& in, std::array<float, 12>& out);
+
+    // Chromagram + result of the last full search; ticks where the sliding
+    // window barely moved return the cached result without searching
+    static constexpr float chromaChangeEpsilon = 1.0e-3f;
+    std::array<float, 12> lastSearchChroma {};
+    Result lastSearchResult;
+    bool lastSearchValid = false;
+
+    // Bin-to-pitch-class lookup, built in prepare(): the mapping depends only
+    // on bin index and sample rate, so the chromagram inner loop reduces to a
+    // table-indexed add over the in-range bin span
+    std::vector<int> binPitchClass;
+    int firstMusicalBin = 0;
+    int lastMusicalBin = 0; // exclusive
+
+    // Sliding-window chromagram: per-frame pitch-class contributions live in
+    // a ring so each update only computes frames for newly arrived audio
+    std::vector<float> frameChroma;      // maxWindowFrames x 12
+    std::array<double, 12> chromaSum {}; // double keeps add/subtract cycles from drifting
+    int maxWindowFrames = 0;
+    int frameRingPos = 0;
+    int framesInRing = 0;
+
+    std::array<float, Pipeline::fftSize> streamBuffer {}; // frame assembly for incoming audio
+    int streamFill = 0;
+
+    void computeFrameChroma(const float* frameData, std::array<float, 12>& chroma);
+    void pushFrameChroma(const std::array<float, 12>& chroma);
 };
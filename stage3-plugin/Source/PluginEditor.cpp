@@ -77,8 +77,8 @@ BPMKeyDetectorAudioProcessorEditor::BPMKeyDetectorAudioProcessorEditor (BPMKeyDe
     };
     addAndMakeVisible (analyzeButton);
 
-    // Start timer to update display (30 FPS)
-    startTimerHz (30);
+    // Start timer to update display
+    setTimerRate (activeTimerHz);
 }
 
 BPMKeyDetectorAudioProcessorEditor::~BPMKeyDetectorAudioProcessorEditor()
@@ -131,21 +131,33 @@ void BPMKeyDetectorAudioProcessorEditor::resized()
 
 void BPMKeyDetectorAudioProcessorEditor::timerCallback()
 {
-    // Update display with current analysis results
-    float bpm = audioProcessor.getCurrentBPM();
-    juce::String key = audioProcessor.getCurrentKey();
-    juce::String mode = audioProcessor.getCurrentMode();
+    bool analyzing = audioProcessor.isAnalyzing();
+    auto snapshot = audioProcessor.getAnalysisSnapshot();
+
+    // Results change every couple of seconds at most; when the sequence
+    // number hasn't advanced there is nothing to relayout or repaint, and
+    // the timer idles down until it does
+    if (snapshot.sequence == lastDisplayedSequence && analyzing == lastDisplayedAnalyzing)
+    {
+        setTimerRate (idleTimerHz);
+        return;
+    }
+
+    lastDisplayedSequence = snapshot.sequence;
+    lastDisplayedAnalyzing = analyzing;
+    setTimerRate (activeTimerHz);
 
     // Update BPM display
-    if (bpm > 0.0f)
-        bpmValueLabel.setText (juce::String (bpm, 1), juce::dontSendNotification);
+    if (snapshot.bpm > 0.0f)
+        bpmValueLabel.setText (juce::String (snapshot.bpm, 1), juce::dontSendNotification);
     else
         bpmValueLabel.setText ("--", juce::dontSendNotification);
 
     // Update Key display
-    if (key.isNotEmpty())
+    if (snapshot.sequence > 0)
     {
-        juce::String keyString = key + " " + mode;
+        juce::String keyString = juce::String (KeyDetector::getPitchClassName (snapshot.keyPitchClass))
+                               + (snapshot.keyIsMinor ? " minor" : " major");
         keyValueLabel.setText (keyString, juce::dontSendNotification);
     }
     else
@@ -154,10 +166,10 @@ void BPMKeyDetectorAudioProcessorEditor::timerCallback()
     }
 
     // Update confidence display
-    if (bpm > 0.0f)
+    if (snapshot.bpm > 0.0f)
     {
-        float bpmConf = audioProcessor.getBPMConfidence();
-        float keyConf = audioProcessor.getKeyConfidence();
+        float bpmConf = snapshot.bpmConfidence;
+        float keyConf = snapshot.keyConfidence;
 
         juce::String confString = "Confidence: BPM ";
         confString += bpmConf >= 0.7f ? "High" : (bpmConf >= 0.4f ? "Medium" : "Low");
@@ -172,8 +184,14 @@ void BPMKeyDetectorAudioProcessorEditor::timerCallback()
     }
 
     // Update button state
-    if (audioProcessor.isAnalyzing() && analyzeButton.getButtonText() == "Start Analysis")
-        analyzeButton.setButtonText ("Stop Analysis");
-    else if (!audioProcessor.isAnalyzing() && analyzeButton.getButtonText() == "Stop Analysis")
-        analyzeButton.setButtonText ("Start Analysis");
+    analyzeButton.setButtonText (analyzing ? "Stop Analysis" : "Start Analysis");
+}
+
+void BPMKeyDetectorAudioProcessorEditor::setTimerRate (int hz)
+{
+    if (currentTimerHz != hz)
+    {
+        currentTimerHz = hz;
+        startTimerHz (hz);
+    }
 }
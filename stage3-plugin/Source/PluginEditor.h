@@ -29,10 +29,20 @@ public:
 private:
     //==============================================================================
     void timerCallback() override;
+    void setTimerRate (int hz);
 
     // Reference to processor
     BPMKeyDetectorAudioProcessor& audioProcessor;
 
+    // Components are only touched when the processor's result sequence
+    // advances; between changes the timer idles at a low rate
+    static constexpr int activeTimerHz = 30;
+    static constexpr int idleTimerHz = 5;
+
+    uint32_t lastDisplayedSequence = 0xffffffff;
+    bool lastDisplayedAnalyzing = false;
+    int currentTimerHz = 0;
+
     // UI Components
     juce::Label titleLabel;
     juce::Label bpmLabel;
@@ -22,11 +22,16 @@ BPMKeyDetectorAudioProcessor::BPMKeyDetectorAudioProcessor()
                        )
 #endif
 {
+    analysisService->registerClient(this);
 }
 
 BPMKeyDetectorAudioProcessor::~BPMKeyDetectorAudioProcessor()
 {
     stopAnalysis();
+
+    // Blocks until any analysis pass still running on the shared pool has
+    // finished touching this instance
+    analysisService->unregisterClient(this);
 }
 
 //==============================================================================
@@ -93,17 +98,95 @@ void BPMKeyDetectorAudioProcessor::changeProgramName (int index, const juce::Str
 //==============================================================================
 void BPMKeyDetectorAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    // Keep any analysis pass still draining on the shared pool out of the
+    // buffers while they are resized
+    const juce::ScopedLock sl(analysisLock);
+
     currentSampleRate = sampleRate;
+    configureAnalysisStorage();
 
-    // Allocate analysis buffer (10 seconds of audio)
-    analysisBufferSize = static_cast<int>(sampleRate * analysisWindowSeconds);
-    analysisBuffer.setSize(2, analysisBufferSize);
-    analysisBuffer.clear();
+    // If the host restored state before preparing us, the detector caches
+    // were stashed and can be applied now that the detectors are sized
+    restoreAnalysisCache();
+}
+
+void BPMKeyDetectorAudioProcessor::configureAnalysisStorage()
+{
+    // Allocate the mono analysis window in the selected precision
+    analysisBufferSize = static_cast<int>(currentSampleRate * analysisWindowSeconds);
     analysisBufferWritePos = 0;
 
-    // Prepare detectors
-    bpmDetector.prepare(sampleRate);
-    keyDetector.prepare(sampleRate);
+    if (use16BitStorage.load())
+    {
+        analysisBuffer16.assign(static_cast<size_t>(analysisBufferSize), 0);
+        analysisBufferFloat.clear();
+        analysisBufferFloat.shrink_to_fit();
+    }
+    else
+    {
+        analysisBufferFloat.assign(static_cast<size_t>(analysisBufferSize), 0.0f);
+        analysisBuffer16.clear();
+        analysisBuffer16.shrink_to_fit();
+    }
+
+    // Size the capture FIFO to hold a full analysis window so the audio
+    // thread never has to wait for the consumer to catch up
+    captureFifo.setTotalSize(analysisBufferSize + 1);
+    captureFifoBuffer.setSize(1, analysisBufferSize + 1);
+    captureFifoBuffer.clear();
+
+    // Prepare detectors - the key detector sees only the decimated rate
+    bpmDetector.prepare(currentSampleRate);
+    keyDecimator.prepare(currentSampleRate);
+    keyDetector.prepare(keyDecimator.getOutputSampleRate(), analysisWindowSeconds);
+
+    decimatedBuffer.resize(static_cast<size_t>(keyDecimator.getMaxOutputSamples(analysisBufferSize)));
+
+    // Stable float snapshot for the analysis pass, preallocated so
+    // performAnalysis never touches the heap
+    monoMixBuffer.setSize(1, analysisBufferSize);
+    monoMixBuffer.clear();
+}
+
+void BPMKeyDetectorAudioProcessor::setAnalysisWindowSeconds(int seconds)
+{
+    seconds = juce::jlimit(2, 60, seconds);
+
+    // The callback lock keeps processBlock off the capture FIFO while it
+    // is reallocated - the audio thread writes it lock-free, so resizing
+    // under analysisLock alone would pull the buffer out from under it.
+    // Same acquisition order as prepareToPlay (callback lock, then
+    // analysisLock), which the host wrapper takes for us.
+    const juce::ScopedLock audioLock(getCallbackLock());
+    const juce::ScopedLock sl(analysisLock);
+
+    if (seconds == analysisWindowSeconds)
+        return;
+
+    analysisWindowSeconds = seconds;
+
+    // A shorter window also shrinks the FIFO, so pull a backed-off cadence
+    // back inside what it can buffer
+    currentUpdateIntervalMs.store(juce::jmin(currentUpdateIntervalMs.load(), seconds * 1000));
+
+    if (analysisBufferSize > 0)
+        configureAnalysisStorage();
+}
+
+void BPMKeyDetectorAudioProcessor::set16BitStorage(bool shouldUse16Bit)
+{
+    // Callback lock first for the same reason as setAnalysisWindowSeconds:
+    // configureAnalysisStorage reallocates the FIFO the audio thread writes
+    const juce::ScopedLock audioLock(getCallbackLock());
+    const juce::ScopedLock sl(analysisLock);
+
+    if (shouldUse16Bit == use16BitStorage.load())
+        return;
+
+    use16BitStorage.store(shouldUse16Bit);
+
+    if (analysisBufferSize > 0)
+        configureAnalysisStorage();
 }
 
 void BPMKeyDetectorAudioProcessor::releaseResources()
@@ -145,25 +228,46 @@ void BPMKeyDetectorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Copy incoming audio to analysis buffer for background processing
+    // Push incoming audio into the lock-free capture FIFO for background
+    // processing. If the FIFO is full (analysis has stalled) the oldest
+    // pending audio simply isn't overwritten - we drop the new block rather
+    // than ever blocking the audio thread.
     if (analyzing.load())
     {
-        const juce::ScopedLock sl(analysisLock);
+        auto captureStart = juce::Time::getHighResolutionTicks();
 
         int numSamples = buffer.getNumSamples();
-        int numChannels = juce::jmin(buffer.getNumChannels(), analysisBuffer.getNumChannels());
+        int numChannels = juce::jmax(1, buffer.getNumChannels());
 
-        for (int channel = 0; channel < numChannels; ++channel)
+        int start1, size1, start2, size2;
+        captureFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        // Mix to mono straight into the FIFO - still block-wise vector ops,
+        // and the capture window only ever stores one channel
+        auto mixRegion = [&](int start, int size, int srcOffset)
         {
-            auto* src = buffer.getReadPointer(channel);
-            auto* dst = analysisBuffer.getWritePointer(channel);
+            if (size <= 0)
+                return;
 
-            for (int i = 0; i < numSamples; ++i)
-            {
-                dst[analysisBufferWritePos] = src[i];
-                analysisBufferWritePos = (analysisBufferWritePos + 1) % analysisBufferSize;
-            }
-        }
+            float* dest = captureFifoBuffer.getWritePointer(0, start);
+
+            juce::FloatVectorOperations::copy(dest, buffer.getReadPointer(0) + srcOffset, size);
+
+            for (int channel = 1; channel < numChannels; ++channel)
+                juce::FloatVectorOperations::add(dest, buffer.getReadPointer(channel) + srcOffset, size);
+
+            if (numChannels > 1)
+                juce::FloatVectorOperations::multiply(dest, 1.0f / static_cast<float>(numChannels), size);
+        };
+
+        mixRegion(start1, size1, 0);
+        mixRegion(start2, size2, size1);
+
+        captureFifo.finishedWrite(size1 + size2);
+
+        recordTiming(lastCaptureSeconds, worstCaptureSeconds, captureHistogram,
+                     juce::Time::highResolutionTicksToSeconds(
+                         juce::Time::getHighResolutionTicks() - captureStart));
     }
 }
 
@@ -181,14 +285,41 @@ juce::AudioProcessorEditor* BPMKeyDetectorAudioProcessor::createEditor()
 //==============================================================================
 void BPMKeyDetectorAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // Save plugin state
+    // Save plugin state: versioned header, compact result fields, then the
+    // detector caches so a reopened session shows results instantly and the
+    // first pass warm-starts instead of recomputing from silence
     juce::MemoryOutputStream stream(destData, true);
 
-    stream.writeFloat(currentBPM.load());
-    stream.writeString(currentKey);
-    stream.writeString(currentMode);
-    stream.writeFloat(bpmConfidence.load());
-    stream.writeFloat(keyConfidence.load());
+    auto snapshot = getAnalysisSnapshot();
+
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateVersion);
+
+    stream.writeFloat(snapshot.bpm);
+    stream.writeFloat(snapshot.bpmConfidence);
+    stream.writeFloat(snapshot.keyConfidence);
+    stream.writeByte(static_cast<char>(snapshot.keyPitchClass));
+    stream.writeBool(snapshot.keyIsMinor);
+
+    {
+        // Analysis passes hold this lock end to end, so a host autosave
+        // during analysis serializes a consistent cache, never a torn one.
+        // Each cache is length-prefixed so a reader that rejects one can be
+        // skipped without desyncing the next.
+        const juce::ScopedLock sl(analysisLock);
+
+        auto writePrefixed = [&stream](const auto& detector)
+        {
+            juce::MemoryOutputStream cacheStream;
+            detector.writeCache(cacheStream);
+
+            stream.writeInt(static_cast<int>(cacheStream.getDataSize()));
+            stream.write(cacheStream.getData(), cacheStream.getDataSize());
+        };
+
+        writePrefixed(bpmDetector);
+        writePrefixed(keyDetector);
+    }
 }
 
 void BPMKeyDetectorAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -196,11 +327,77 @@ void BPMKeyDetectorAudioProcessor::setStateInformation (const void* data, int si
     // Restore plugin state
     juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
 
-    currentBPM.store(stream.readFloat());
-    currentKey = stream.readString();
-    currentMode = stream.readString();
-    bpmConfidence.store(stream.readFloat());
-    keyConfidence.store(stream.readFloat());
+    AnalysisSnapshot snapshot;
+
+    if (sizeInBytes >= 8 && stream.readInt() == stateMagic)
+    {
+        if (stream.readInt() != stateVersion)
+            return;
+
+        snapshot.bpm = stream.readFloat();
+        snapshot.bpmConfidence = stream.readFloat();
+        snapshot.keyConfidence = stream.readFloat();
+        snapshot.keyPitchClass = juce::jlimit(0, 11, static_cast<int>(stream.readByte()));
+        snapshot.keyIsMinor = stream.readBool();
+
+        // Stash the detector caches - they can only be applied once the
+        // detectors are prepared for the session sample rate
+        analysisCacheBlob.reset();
+        stream.readIntoMemoryBlock(analysisCacheBlob);
+        restoreAnalysisCache();
+    }
+    else
+    {
+        // Legacy loose float/string format from version 1 sessions
+        stream.setPosition(0);
+
+        snapshot.bpm = stream.readFloat();
+        juce::String key = stream.readString();
+        snapshot.keyIsMinor = stream.readString() == "minor";
+        snapshot.bpmConfidence = stream.readFloat();
+        snapshot.keyConfidence = stream.readFloat();
+
+        for (int i = 0; i < 12; ++i)
+            if (key == KeyDetector::getPitchClassName(i))
+                snapshot.keyPitchClass = i;
+    }
+
+    snapshot.sequence = getResultSequence() + 1;
+    resultSnapshot.store(packSnapshot(snapshot));
+}
+
+void BPMKeyDetectorAudioProcessor::restoreAnalysisCache()
+{
+    if (analysisCacheBlob.getSize() == 0 || analysisBufferSize == 0)
+        return;
+
+    // Same lock as the analysis pass, so the caches never apply into
+    // detectors an in-flight job is streaming into
+    const juce::ScopedLock sl(analysisLock);
+    juce::MemoryInputStream cache(analysisCacheBlob, false);
+
+    // However a reader fails - early validation return, truncated payload -
+    // the length prefix realigns the stream to the next cache, so one bad
+    // restore can't feed the next reader someone else's bytes
+    auto readPrefixed = [&cache](auto& detector)
+    {
+        int numBytes = cache.readInt();
+
+        if (numBytes < 0 || static_cast<juce::int64>(numBytes) > cache.getNumBytesRemaining())
+            return false;
+
+        juce::int64 next = cache.getPosition() + numBytes;
+        bool restored = detector.readCache(cache) && cache.getPosition() <= next;
+        cache.setPosition(next);
+
+        return restored;
+    };
+
+    bool bpmRestored = readPrefixed(bpmDetector);
+    bool keyRestored = readPrefixed(keyDetector);
+
+    analysisCacheWarm = bpmRestored && keyRestored;
+    analysisCacheBlob.reset();
 }
 
 //==============================================================================
@@ -208,66 +405,368 @@ void BPMKeyDetectorAudioProcessor::startAnalysis()
 {
     if (!analyzing.load())
     {
+        {
+            const juce::ScopedLock sl(analysisLock);
+            analysisBufferWritePos = 0;
+            std::fill(analysisBufferFloat.begin(), analysisBufferFloat.end(), 0.0f);
+            std::fill(analysisBuffer16.begin(), analysisBuffer16.end(), juce::int16(0));
+            captureFifo.reset();
+            keyDecimator.resetStream();
+
+            // A warm cache restored from session state survives the first
+            // start, so reopened projects converge instead of starting cold
+            if (!analysisCacheWarm)
+            {
+                keyDetector.resetStream();
+                bpmDetector.resetStream();
+            }
+
+            analysisCacheWarm = false;
+        }
+
+        // Fast cadence until the first confident, stable results arrive
+        currentUpdateIntervalMs.store(fastUpdateIntervalMs);
+        stablePassCount = 0;
+        schedulerSmoothedRMS = -1.0f;
+
+        nextAnalysisDueMs.store(juce::Time::currentTimeMillis() + fastUpdateIntervalMs);
         analyzing.store(true);
-        analysisBufferWritePos = 0;
-        analysisBuffer.clear();
     }
 }
 
 void BPMKeyDetectorAudioProcessor::stopAnalysis()
 {
+    // The shared service simply stops seeing this instance as due; any pass
+    // already in flight finishes on its own under analysisLock
     analyzing.store(false);
 }
 
+bool BPMKeyDetectorAudioProcessor::isAnalysisDue()
+{
+    return analyzing.load() && juce::Time::currentTimeMillis() >= nextAnalysisDueMs.load();
+}
+
+void BPMKeyDetectorAudioProcessor::runAnalysisJob()
+{
+    if (analyzing.load())
+        performAnalysis();
+
+    nextAnalysisDueMs.store(juce::Time::currentTimeMillis() + currentUpdateIntervalMs.load());
+}
+
+bool BPMKeyDetectorAudioProcessor::isAnalysisJobUrgent()
+{
+    // An open editor means someone is watching this instance's results
+    return getActiveEditor() != nullptr;
+}
+
 void BPMKeyDetectorAudioProcessor::performAnalysis()
 {
-    // This would be called periodically to analyze the collected audio
+    auto passStart = juce::Time::getHighResolutionTicks();
+
+    // Held for the whole pass. The audio thread never takes this lock (it
+    // only writes the wait-free FIFO), so nothing real-time is blocked -
+    // but prepareToPlay, the storage setters and state save/load do take
+    // it, and they resize monoMixBuffer and re-prepare the very detectors
+    // this pass streams into.
     const juce::ScopedLock sl(analysisLock);
 
-    if (analysisBuffer.getNumSamples() == 0)
+    if (analysisBufferSize == 0 || monoMixBuffer.getNumSamples() < analysisBufferSize)
         return;
 
-    // Convert to mono for analysis
-    juce::AudioBuffer<float> monoBuffer(1, analysisBufferSize);
-    monoBuffer.clear();
+    // Pull everything the audio thread has captured since the last pass
+    // into the circular analysis window
+    int numNewSamples = juce::jmin(drainCaptureFifo(), analysisBufferSize);
+    int snapshotWritePos = analysisBufferWritePos;
+
+    // Capture is already mono, so the old mixdown step collapses into
+    // the snapshot copy (or a widening convert in 16-bit mode)
+    auto mixdownStart = juce::Time::getHighResolutionTicks();
+    float* mono = monoMixBuffer.getWritePointer(0);
 
-    if (analysisBuffer.getNumChannels() > 1)
+    if (use16BitStorage.load())
     {
-        // Average stereo to mono
+        constexpr float scale = 1.0f / 32767.0f;
+
         for (int i = 0; i < analysisBufferSize; ++i)
-        {
-            float sum = 0.0f;
-            for (int ch = 0; ch < analysisBuffer.getNumChannels(); ++ch)
-                sum += analysisBuffer.getSample(ch, i);
-            monoBuffer.setSample(0, i, sum / analysisBuffer.getNumChannels());
-        }
+            mono[i] = static_cast<float>(analysisBuffer16[static_cast<size_t>(i)]) * scale;
     }
     else
     {
-        monoBuffer.copyFrom(0, 0, analysisBuffer, 0, 0, analysisBufferSize);
+        juce::FloatVectorOperations::copy(mono, analysisBufferFloat.data(), analysisBufferSize);
+    }
+
+    lastMixdownSeconds.store(juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - mixdownStart));
+
+    // Both detectors are incremental now: stream only the newly captured
+    // region into their persistent envelope/chromagram state instead of
+    // recomputing the whole 10-second window every tick
+    int newStart = (snapshotWritePos - numNewSamples + analysisBufferSize) % analysisBufferSize;
+    int remaining = numNewSamples;
+    double bpmSeconds = 0.0;
+    double keySeconds = 0.0;
+
+    while (remaining > 0)
+    {
+        int chunk = juce::jmin(remaining, analysisBufferSize - newStart);
+        const float* newAudio = mono + newStart;
+
+        auto bpmStart = juce::Time::getHighResolutionTicks();
+        bpmDetector.pushAudio(newAudio, chunk);
+        auto keyStart = juce::Time::getHighResolutionTicks();
+        bpmSeconds += juce::Time::highResolutionTicksToSeconds(keyStart - bpmStart);
+
+        int numDecimated = keyDecimator.processStream(newAudio, chunk, decimatedBuffer.data());
+        keyDetector.pushAudio(decimatedBuffer.data(), numDecimated);
+        keySeconds += juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - keyStart);
+
+        newStart = (newStart + chunk) % analysisBufferSize;
+        remaining -= chunk;
     }
 
-    // Perform BPM detection
-    float bpm = bpmDetector.detectBPM(monoBuffer.getReadPointer(0), analysisBufferSize);
+    auto bpmDetectStart = juce::Time::getHighResolutionTicks();
+    float bpm = bpmDetector.detectBPMIncremental();
     float bpmConf = bpmDetector.getConfidence();
 
-    // Perform key detection
-    auto [key, mode, keyConf] = keyDetector.detectKey(monoBuffer.getReadPointer(0), analysisBufferSize);
+    auto keyDetectStart = juce::Time::getHighResolutionTicks();
+    bpmSeconds += juce::Time::highResolutionTicksToSeconds(keyDetectStart - bpmDetectStart);
+
+    auto keyResult = keyDetector.detectKeyIncremental();
+    keySeconds += juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - keyDetectStart);
+
+    lastBPMSeconds.store(bpmSeconds);
+    lastKeySeconds.store(keySeconds);
 
     // Update results
-    updateAnalysisResults(bpm, bpmConf, key, mode, keyConf);
+    updateAnalysisResults(bpm, bpmConf, keyResult);
+
+    updateScheduler(bpm, bpmConf, keyResult,
+                    monoMixBuffer.getRMSLevel(0, 0, analysisBufferSize));
+
+    recordTiming(lastAnalysisSeconds, worstAnalysisSeconds, analysisHistogram,
+                 juce::Time::highResolutionTicksToSeconds(
+                     juce::Time::getHighResolutionTicks() - passStart));
+}
+
+int BPMKeyDetectorAudioProcessor::perfHistogramBinFor(double seconds)
+{
+    double microseconds = seconds * 1.0e6;
+    int bin = 0;
+
+    while (microseconds >= 1.0 && bin < perfHistogramBins - 1)
+    {
+        microseconds *= 0.5;
+        ++bin;
+    }
+
+    return bin;
+}
+
+void BPMKeyDetectorAudioProcessor::recordTiming(
+    std::atomic<double>& last, std::atomic<double>& worst,
+    std::array<std::atomic<uint32_t>, perfHistogramBins>& histogram, double seconds)
+{
+    last.store(seconds);
+
+    double previousWorst = worst.load();
+    while (seconds > previousWorst && !worst.compare_exchange_weak(previousWorst, seconds))
+    {
+    }
+
+    histogram[static_cast<size_t>(perfHistogramBinFor(seconds))].fetch_add(1);
+}
+
+std::array<uint32_t, BPMKeyDetectorAudioProcessor::perfHistogramBins>
+BPMKeyDetectorAudioProcessor::getCaptureHistogram() const
+{
+    std::array<uint32_t, perfHistogramBins> counts;
+    for (int i = 0; i < perfHistogramBins; ++i)
+        counts[static_cast<size_t>(i)] = captureHistogram[static_cast<size_t>(i)].load();
+    return counts;
+}
+
+std::array<uint32_t, BPMKeyDetectorAudioProcessor::perfHistogramBins>
+BPMKeyDetectorAudioProcessor::getAnalysisHistogram() const
+{
+    std::array<uint32_t, perfHistogramBins> counts;
+    for (int i = 0; i < perfHistogramBins; ++i)
+        counts[static_cast<size_t>(i)] = analysisHistogram[static_cast<size_t>(i)].load();
+    return counts;
+}
+
+void BPMKeyDetectorAudioProcessor::resetPerformanceCounters()
+{
+    lastCaptureSeconds.store(0.0);
+    worstCaptureSeconds.store(0.0);
+    lastMixdownSeconds.store(0.0);
+    lastBPMSeconds.store(0.0);
+    lastKeySeconds.store(0.0);
+    lastAnalysisSeconds.store(0.0);
+    worstAnalysisSeconds.store(0.0);
+
+    for (auto& bin : captureHistogram)
+        bin.store(0);
+    for (auto& bin : analysisHistogram)
+        bin.store(0);
+}
+
+int BPMKeyDetectorAudioProcessor::drainCaptureFifo()
+{
+    int start1, size1, start2, size2;
+    captureFifo.prepareToRead(captureFifo.getNumReady(), start1, size1, start2, size2);
+
+    appendToAnalysisBuffer(start1, size1);
+    appendToAnalysisBuffer(start2, size2);
+
+    captureFifo.finishedRead(size1 + size2);
+
+    return size1 + size2;
+}
+
+void BPMKeyDetectorAudioProcessor::appendToAnalysisBuffer(int fifoStart, int numSamples)
+{
+    int offset = 0;
+
+    while (numSamples > 0)
+    {
+        // Copy up to the wrap point of the circular analysis window
+        int samplesToCopy = juce::jmin(numSamples, analysisBufferSize - analysisBufferWritePos);
+        const float* src = captureFifoBuffer.getReadPointer(0, fifoStart + offset);
+
+        if (use16BitStorage.load())
+        {
+            juce::int16* dest = analysisBuffer16.data() + analysisBufferWritePos;
+
+            for (int i = 0; i < samplesToCopy; ++i)
+                dest[i] = static_cast<juce::int16>(
+                    juce::jlimit(-1.0f, 1.0f, src[i]) * 32767.0f);
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(analysisBufferFloat.data() + analysisBufferWritePos,
+                                              src, samplesToCopy);
+        }
+
+        analysisBufferWritePos = (analysisBufferWritePos + samplesToCopy) % analysisBufferSize;
+        offset += samplesToCopy;
+        numSamples -= samplesToCopy;
+    }
+}
+
+void BPMKeyDetectorAudioProcessor::updateScheduler(float bpm, float bpmConf,
+                                                   const KeyDetector::Result& key,
+                                                   float windowRMS)
+{
+    // Detect a shift in the incoming signal level (more than ~6 dB either
+    // way against the smoothed reference)
+    bool signalShifted = false;
+
+    if (schedulerSmoothedRMS >= 0.0f)
+    {
+        float reference = juce::jmax(schedulerSmoothedRMS, 1.0e-6f);
+        float ratio = juce::jmax(windowRMS, 1.0e-6f) / reference;
+        signalShifted = ratio > 2.0f || ratio < 0.5f;
+
+        schedulerSmoothedRMS = 0.9f * schedulerSmoothedRMS + 0.1f * windowRMS;
+    }
+    else
+    {
+        schedulerSmoothedRMS = windowRMS;
+    }
+
+    bool resultsStable = bpm > 0.0f
+                      && bpmConf >= backoffConfidenceThreshold
+                      && key.confidence >= backoffConfidenceThreshold
+                      && std::abs(bpm - lastScheduledBPM) < 1.0f
+                      && key.pitchClass == lastScheduledPitchClass
+                      && key.isMinor == lastScheduledMinor;
+
+    lastScheduledBPM = bpm;
+    lastScheduledPitchClass = key.pitchClass;
+    lastScheduledMinor = key.isMinor;
+
+    if (signalShifted)
+    {
+        // New material - back to fast mode for quick reconvergence
+        currentUpdateIntervalMs.store(fastUpdateIntervalMs);
+        stablePassCount = 0;
+    }
+    else if (resultsStable)
+    {
+        // Back off exponentially once results have settled, but never past
+        // what the capture FIFO can buffer between passes - beyond one
+        // analysis window per cycle the audio thread starts dropping blocks
+        // and every pass analyzes stale audio
+        int backoffCeilingMs = juce::jmin(maxUpdateIntervalMs, analysisWindowSeconds * 1000);
+
+        if (++stablePassCount >= 2)
+            currentUpdateIntervalMs.store(juce::jmin(backoffCeilingMs,
+                juce::jmax(analysisUpdateIntervalMs, currentUpdateIntervalMs.load() * 2)));
+    }
+    else
+    {
+        currentUpdateIntervalMs.store(analysisUpdateIntervalMs);
+        stablePassCount = 0;
+    }
 }
 
 void BPMKeyDetectorAudioProcessor::updateAnalysisResults(float bpm, float bpmConf,
-                                                         const juce::String& key,
-                                                         const juce::String& mode,
-                                                         float keyConf)
-{
-    currentBPM.store(bpm);
-    bpmConfidence.store(bpmConf);
-    currentKey = key;
-    currentMode = mode;
-    keyConfidence.store(keyConf);
+                                                         const KeyDetector::Result& key)
+{
+    // Single writer: analysis jobs for one instance never overlap, so the
+    // read-increment of the sequence number cannot race
+    AnalysisSnapshot snapshot;
+    snapshot.bpm = bpm;
+    snapshot.bpmConfidence = bpmConf;
+    snapshot.keyConfidence = key.confidence;
+    snapshot.keyPitchClass = key.pitchClass;
+    snapshot.keyIsMinor = key.isMinor;
+    snapshot.sequence = getResultSequence() + 1;
+
+    resultSnapshot.store(packSnapshot(snapshot));
+}
+
+BPMKeyDetectorAudioProcessor::AnalysisSnapshot
+BPMKeyDetectorAudioProcessor::getAnalysisSnapshot() const
+{
+    uint64_t packed = resultSnapshot.load();
+
+    AnalysisSnapshot snapshot;
+    snapshot.bpm = static_cast<float>(packed & 0xffff) * 0.1f;
+    snapshot.bpmConfidence = static_cast<float>((packed >> 16) & 0xff) / 255.0f;
+    snapshot.keyConfidence = static_cast<float>((packed >> 24) & 0xff) / 255.0f;
+    snapshot.keyPitchClass = static_cast<int>((packed >> 32) & 0xf);
+    snapshot.keyIsMinor = ((packed >> 36) & 1) != 0;
+    snapshot.sequence = static_cast<uint32_t>(packed >> sequenceShift);
+
+    return snapshot;
+}
+
+uint64_t BPMKeyDetectorAudioProcessor::packSnapshot(const AnalysisSnapshot& snapshot)
+{
+    auto bpmTenths = static_cast<uint64_t>(juce::jlimit(0.0f, 6553.5f, snapshot.bpm) * 10.0f + 0.5f);
+    auto bpmConf = static_cast<uint64_t>(juce::jlimit(0.0f, 1.0f, snapshot.bpmConfidence) * 255.0f + 0.5f);
+    auto keyConf = static_cast<uint64_t>(juce::jlimit(0.0f, 1.0f, snapshot.keyConfidence) * 255.0f + 0.5f);
+
+    return bpmTenths
+         | (bpmConf << 16)
+         | (keyConf << 24)
+         | (static_cast<uint64_t>(snapshot.keyPitchClass & 0xf) << 32)
+         | (snapshot.keyIsMinor ? (1ull << 36) : 0)
+         | (static_cast<uint64_t>(snapshot.sequence & 0xffffff) << sequenceShift);
+}
+
+juce::String BPMKeyDetectorAudioProcessor::getCurrentKey() const
+{
+    return KeyDetector::getPitchClassName(getAnalysisSnapshot().keyPitchClass);
+}
+
+juce::String BPMKeyDetectorAudioProcessor::getCurrentMode() const
+{
+    return getAnalysisSnapshot().keyIsMinor ? "minor" : "major";
 }
 
 //==============================================================================
@@ -10,14 +10,17 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AnalysisService.h"
 #include "BPMDetector.h"
 #include "KeyDetector.h"
+#include "Decimator.h"
 
 //==============================================================================
 /**
     Main audio plugin processor for BPM and Key detection.
 */
-class BPMKeyDetectorAudioProcessor : public juce::AudioProcessor
+class BPMKeyDetectorAudioProcessor : public juce::AudioProcessor,
+                                     private AnalysisService::Client
 {
 public:
     //==============================================================================
@@ -58,52 +61,182 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     //==============================================================================
-    // Analysis results
-    float getCurrentBPM() const { return currentBPM.load(); }
-    juce::String getCurrentKey() const { return currentKey; }
-    juce::String getCurrentMode() const { return currentMode; }
-    float getBPMConfidence() const { return bpmConfidence.load(); }
-    float getKeyConfidence() const { return keyConfidence.load(); }
+    // Analysis results. The whole result set is published through one packed
+    // atomic word, so reads never tear against the analysis thread and
+    // publishing never allocates; key/mode strings are derived lazily.
+    struct AnalysisSnapshot
+    {
+        float bpm = 0.0f;
+        float bpmConfidence = 0.0f;
+        float keyConfidence = 0.0f;
+        int keyPitchClass = 0;
+        bool keyIsMinor = false;
+        uint32_t sequence = 0; // bumps on every publish
+    };
+
+    AnalysisSnapshot getAnalysisSnapshot() const;
+
+    /** Cheap change check: the sequence number from the packed word. */
+    uint32_t getResultSequence() const { return static_cast<uint32_t>(resultSnapshot.load() >> sequenceShift); }
+
+    float getCurrentBPM() const { return getAnalysisSnapshot().bpm; }
+    juce::String getCurrentKey() const;
+    juce::String getCurrentMode() const;
+    float getBPMConfidence() const { return getAnalysisSnapshot().bpmConfidence; }
+    float getKeyConfidence() const { return getAnalysisSnapshot().keyConfidence; }
 
     bool isAnalyzing() const { return analyzing.load(); }
     void startAnalysis();
     void stopAnalysis();
 
+    //==============================================================================
+    // Capture storage configuration. Capture is mixed to mono at write time
+    // (the detectors only ever consume mono), the window length is a runtime
+    // setting, and 16-bit storage halves the window again when memory is
+    // tighter than precision.
+    int getAnalysisWindowSeconds() const { return analysisWindowSeconds; }
+    void setAnalysisWindowSeconds(int seconds);
+
+    bool isUsing16BitStorage() const { return use16BitStorage.load(); }
+    void set16BitStorage(bool shouldUse16Bit);
+
+    //==============================================================================
+    // Hot-path performance counters, polled by the editor / telemetry the
+    // same way as the result atomics above. Times are in seconds; the
+    // histograms use log2 microsecond buckets (bin 0 = under 1 us, each
+    // following bin doubles, the top bin is open-ended).
+    static constexpr int perfHistogramBins = 16;
+
+    double getLastCaptureSeconds() const { return lastCaptureSeconds.load(); }
+    double getWorstCaptureSeconds() const { return worstCaptureSeconds.load(); }
+    double getLastMixdownSeconds() const { return lastMixdownSeconds.load(); }
+    double getLastBPMDetectSeconds() const { return lastBPMSeconds.load(); }
+    double getLastKeyDetectSeconds() const { return lastKeySeconds.load(); }
+    double getLastAnalysisSeconds() const { return lastAnalysisSeconds.load(); }
+    double getWorstAnalysisSeconds() const { return worstAnalysisSeconds.load(); }
+
+    std::array<uint32_t, perfHistogramBins> getCaptureHistogram() const;
+    std::array<uint32_t, perfHistogramBins> getAnalysisHistogram() const;
+
+    void resetPerformanceCounters();
+
 private:
     //==============================================================================
     // Audio analysis
     BPMDetector bpmDetector;
     KeyDetector keyDetector;
 
-    // Circular buffer for analysis
-    juce::AudioBuffer<float> analysisBuffer;
+    // Key detection runs on a decimated (~12 kHz) copy of the window - it
+    // discards everything above 4186 Hz, so full-rate spectra waste work
+    Decimator keyDecimator;
+    std::vector<float> decimatedBuffer;
+
+    // Mono circular capture window - one float (or int16) per sample
+    // instead of a stereo pair, since mixing happens at write time
+    std::vector<float> analysisBufferFloat;
+    std::vector<juce::int16> analysisBuffer16;
+    std::atomic<bool> use16BitStorage { false };
     int analysisBufferWritePos = 0;
     int analysisBufferSize = 0;
 
-    // Analysis state
-    std::atomic<float> currentBPM { 0.0f };
-    std::atomic<float> bpmConfidence { 0.0f };
-    std::atomic<float> keyConfidence { 0.0f };
-    juce::String currentKey = "C";
-    juce::String currentMode = "major";
+    // Stable float copy of the window for the analysis pass, which runs
+    // under analysisLock end to end so reconfiguration can never resize it
+    // (or re-prepare the detectors) mid-pass
+    juce::AudioBuffer<float> monoMixBuffer;
+
+    // Wait-free single-producer/single-consumer FIFO between the audio
+    // thread (producer) and the analysis side (consumer). The audio thread
+    // only ever does block-wise mono mixes into captureFifoBuffer - it
+    // never takes a lock and never branches per sample.
+    juce::AbstractFifo captureFifo { 1 };
+    juce::AudioBuffer<float> captureFifoBuffer;
+
+    void configureAnalysisStorage(); // sizes buffers + prepares detectors
+
+    // Analysis state, packed into a single atomic word:
+    //   bits  0-15  BPM in tenths
+    //   bits 16-23  BPM confidence x 255
+    //   bits 24-31  key confidence x 255
+    //   bits 32-35  key pitch class (0-11)
+    //   bit  36     mode (1 = minor)
+    //   bits 40-63  sequence number (wraps)
+    static constexpr int sequenceShift = 40;
+    std::atomic<uint64_t> resultSnapshot { 0 };
     std::atomic<bool> analyzing { false };
 
+    static uint64_t packSnapshot(const AnalysisSnapshot& snapshot);
+
+    // Versioned binary state: magic + version up front so legacy or foreign
+    // blobs are detected instead of misparsed. Version 2 added the packed
+    // result fields and the persisted analysis cache; version 3
+    // length-prefixes each detector cache and records the capture rate.
+    static constexpr juce::int32 stateMagic = 0x424b4453; // "BKDS"
+    static constexpr juce::int32 stateVersion = 3;
+
+    juce::MemoryBlock analysisCacheBlob; // detector caches awaiting prepare
+    bool analysisCacheWarm = false;      // skip one reset so warm state survives
+    void restoreAnalysisCache();
+
     // Threading
     juce::CriticalSection analysisLock;
-    std::unique_ptr<juce::Thread> analysisThread;
+
+    // All instances in the process share one analysis scheduler and one
+    // bounded thread pool; this instance is polled as a service client
+    juce::SharedResourcePointer<AnalysisService> analysisService;
+    std::atomic<juce::int64> nextAnalysisDueMs { 0 };
+
+    bool isAnalysisDue() override;
+    void runAnalysisJob() override;
+    bool isAnalysisJobUrgent() override;
 
     // Sample rate
     double currentSampleRate = 44100.0;
 
     // Analysis parameters
-    static constexpr int analysisWindowSeconds = 10; // Analyze 10 seconds of audio
-    static constexpr int analysisUpdateIntervalMs = 2000; // Update every 2 seconds
+    static constexpr int defaultAnalysisWindowSeconds = 10;
+    int analysisWindowSeconds = defaultAnalysisWindowSeconds; // runtime-adjustable
+    static constexpr int analysisUpdateIntervalMs = 2000; // Baseline cadence
+
+    // Adaptive scheduler: fast passes right after startAnalysis() for quick
+    // first results, exponential backoff while results stay stable and
+    // confident, snapping back when the signal statistics shift. The
+    // effective backoff is additionally capped at analysisWindowSeconds,
+    // since the capture FIFO only holds one window of audio.
+    static constexpr int fastUpdateIntervalMs = 500;
+    static constexpr int maxUpdateIntervalMs = 32000;
+    static constexpr float backoffConfidenceThreshold = 0.7f;
+
+    std::atomic<int> currentUpdateIntervalMs { fastUpdateIntervalMs };
+    int stablePassCount = 0;          // analysis job only
+    float schedulerSmoothedRMS = -1.0f;
+    float lastScheduledBPM = 0.0f;
+    int lastScheduledPitchClass = -1;
+    bool lastScheduledMinor = false;
+
+    void updateScheduler(float bpm, float bpmConf,
+                        const KeyDetector::Result& key, float windowRMS);
+
+    // Performance counters
+    std::atomic<double> lastCaptureSeconds { 0.0 };
+    std::atomic<double> worstCaptureSeconds { 0.0 };
+    std::atomic<double> lastMixdownSeconds { 0.0 };
+    std::atomic<double> lastBPMSeconds { 0.0 };
+    std::atomic<double> lastKeySeconds { 0.0 };
+    std::atomic<double> lastAnalysisSeconds { 0.0 };
+    std::atomic<double> worstAnalysisSeconds { 0.0 };
+    std::array<std::atomic<uint32_t>, perfHistogramBins> captureHistogram {};
+    std::array<std::atomic<uint32_t>, perfHistogramBins> analysisHistogram {};
+
+    static int perfHistogramBinFor(double seconds);
+    static void recordTiming(std::atomic<double>& last, std::atomic<double>& worst,
+                            std::array<std::atomic<uint32_t>, perfHistogramBins>& histogram,
+                            double seconds);
 
     void performAnalysis();
+    int drainCaptureFifo();
+    void appendToAnalysisBuffer(int fifoStart, int numSamples);
     void updateAnalysisResults(float bpm, float bpmConf,
-                              const juce::String& key,
-                              const juce::String& mode,
-                              float keyConf);
+                              const KeyDetector::Result& key);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BPMKeyDetectorAudioProcessor)
 };
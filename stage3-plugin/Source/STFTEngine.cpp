@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    Shared STFT Engine Implementation
+    One windowing + transform pass per hop, shared by BPM and key detection
+
+  ==============================================================================
+*/
+
+#include "STFTEngine.h"
+
+void STFTEngine::prepare(double sr, int maxNumSamples)
+{
+    sampleRate = sr;
+
+    // Hann window table, computed once
+    window = createHannWindow(fftSize);
+
+    maxFrames = juce::jmax(0, (maxNumSamples - fftSize) / hopSize);
+    frames.resize(static_cast<size_t>(maxFrames) * numBins);
+    numFrames = 0;
+
+    // One workspace per pool thread plus one for the calling thread
+    workspaces.clear();
+    for (int i = 0; i < pool.getNumThreads() + 1; ++i)
+    {
+        auto workspace = std::make_unique<FrameWorkspace>();
+        workspace->fftBuffer.resize(fftSize * 2);
+        workspaces.push_back(std::move(workspace));
+    }
+}
+
+int STFTEngine::analyze(const float* audioData, int numSamples)
+{
+    numFrames = juce::jlimit(0, maxFrames, (numSamples - fftSize) / hopSize);
+
+    if (numFrames == 0)
+        return 0;
+
+    int numChunks = juce::jmin(static_cast<int>(workspaces.size()), numFrames);
+    int framesPerChunk = (numFrames + numChunks - 1) / numChunks;
+
+    std::atomic<int> chunksRemaining { numChunks - 1 };
+    juce::WaitableEvent allChunksDone;
+
+    // Chunks 1..n-1 go to the pool; chunk 0 runs on the calling thread
+    for (int chunk = 1; chunk < numChunks; ++chunk)
+    {
+        int firstFrame = chunk * framesPerChunk;
+        int lastFrame = juce::jmin(numFrames, firstFrame + framesPerChunk);
+        auto* workspace = workspaces[static_cast<size_t>(chunk)].get();
+
+        pool.addJob([this, audioData, firstFrame, lastFrame, workspace,
+                     &chunksRemaining, &allChunksDone]
+        {
+            analyzeFrameRange(audioData, firstFrame, lastFrame, *workspace);
+
+            if (--chunksRemaining == 0)
+                allChunksDone.signal();
+        });
+    }
+
+    analyzeFrameRange(audioData, 0, juce::jmin(numFrames, framesPerChunk), *workspaces.front());
+
+    if (numChunks > 1)
+        allChunksDone.wait();
+
+    return numFrames;
+}
+
+void STFTEngine::analyzeFrameRange(const float* audioData, int firstFrame, int lastFrame,
+                                   FrameWorkspace& workspace)
+{
+    for (int frame = firstFrame; frame < lastFrame; ++frame)
+    {
+        const float* input = audioData + frame * hopSize;
+        float* magnitudes = frames.data() + static_cast<size_t>(frame) * numBins;
+
+        // Window into the transform workspace
+        juce::FloatVectorOperations::multiply(workspace.fftBuffer.data(), input,
+                                              window.data(), fftSize);
+        juce::FloatVectorOperations::clear(workspace.fftBuffer.data() + fftSize, fftSize);
+
+        // Real-input transform, leaving bin magnitudes in place
+        workspace.fft.performFrequencyOnlyForwardTransform(workspace.fftBuffer.data());
+
+        juce::FloatVectorOperations::copy(magnitudes, workspace.fftBuffer.data(), numBins);
+    }
+}
+
+std::vector<float> STFTEngine::createHannWindow(int size)
+{
+    std::vector<float> window(static_cast<size_t>(size));
+
+    for (int i = 0; i < size; ++i)
+        window[i] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (size - 1)));
+
+    return window;
+}
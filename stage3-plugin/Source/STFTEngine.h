@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    STFT Engine
+    Batch STFT pass used by the benchmark harness
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+    Runs a single STFT pass over an audio buffer and keeps the magnitude
+    spectrum of every hop. The plugin's detectors moved to their own
+    incremental streaming transforms; this batch pass remains as a
+    benchmark-only utility.
+*/
+class STFTEngine
+{
+public:
+    STFTEngine() = default;
+    ~STFTEngine() = default;
+
+    // STFT parameters shared by all consumers. The 4096-point resolution
+    // is what the key detector needs; the onset analysis derives its
+    // coarser view from the same frames.
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder; // 4096
+    static constexpr int hopSize = 512;
+    static constexpr int numBins = fftSize / 2;
+
+    void prepare(double sampleRate, int maxNumSamples);
+
+    /**
+     * Run one STFT pass over the buffer.
+     * @param audioData Pointer to mono audio data
+     * @param numSamples Number of samples
+     * @return Number of frames computed
+     */
+    int analyze(const float* audioData, int numSamples);
+
+    int getNumFrames() const { return numFrames; }
+
+    /** Magnitude spectrum (numBins values) of one analysed frame. */
+    const float* getMagnitudes(int frame) const
+    {
+        return frames.data() + static_cast<size_t>(frame) * numBins;
+    }
+
+    double getSampleRate() const { return sampleRate; }
+
+    /** Builds a Hann window table of the given length, shared by every
+        analysis stage so nobody recomputes a cos per sample per frame. */
+    static std::vector<float> createHannWindow(int size);
+
+private:
+    double sampleRate = 44100.0;
+    int numFrames = 0;
+    int maxFrames = 0;
+
+    std::vector<float> window; // Hann window table, built in prepare()
+    std::vector<float> frames; // maxFrames x numBins magnitudes
+
+    // Each frame's window+FFT+magnitude is independent, so the frame loop is
+    // partitioned into contiguous chunks across a pool, each chunk writing a
+    // disjoint row range of the frames matrix with its own scratch + plan
+    struct FrameWorkspace
+    {
+        juce::dsp::FFT fft { fftOrder };
+        std::vector<float> fftBuffer; // real-transform workspace
+    };
+
+    juce::ThreadPool pool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+    std::vector<std::unique_ptr<FrameWorkspace>> workspaces;
+
+    void analyzeFrameRange(const float* audioData, int firstFrame, int lastFrame,
+                          FrameWorkspace& workspace);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFTEngine)
+};